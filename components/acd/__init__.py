@@ -0,0 +1,116 @@
+# ACD 系列红外气体传感器的公共驱动, 各型号只提供 traits 和气体传感器的 schema
+# 命令和帧格式见各型号目录下的说明书
+from esphome import automation
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor, i2c
+from esphome.const import (
+    CONF_ID,
+    CONF_TEMPERATURE,
+    CONF_MODE,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_PARTS_PER_MILLION,
+    DEVICE_CLASS_CARBON_DIOXIDE, UNIT_CELSIUS, DEVICE_CLASS_TEMPERATURE,
+)
+
+CODEOWNERS = ["@synodriver"]
+DEPENDENCIES = ["i2c"]
+AUTO_LOAD = ["aosong_crc"]
+
+CONF_BASE = "base"
+CONF_BASE_INTERVAL = "base_interval"
+
+acd_ns = cg.esphome_ns.namespace("acd")
+ACDComponent = acd_ns.class_("ACDComponent", cg.PollingComponent, i2c.I2CDevice)
+
+
+def acd_schema(component, gas_key, gas_schema):
+    return cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(component),
+            cv.Optional(gas_key): gas_schema,
+            cv.Optional(CONF_TEMPERATURE): sensor.sensor_schema(
+                unit_of_measurement=UNIT_CELSIUS,
+                accuracy_decimals=0,
+                device_class=DEVICE_CLASS_TEMPERATURE,
+                state_class=STATE_CLASS_MEASUREMENT,
+            ),
+            cv.Optional(CONF_BASE): sensor.sensor_schema(
+                unit_of_measurement=UNIT_PARTS_PER_MILLION,
+                accuracy_decimals=0,
+                device_class=DEVICE_CLASS_CARBON_DIOXIDE,
+                state_class=STATE_CLASS_MEASUREMENT,
+            ),
+            # 基准值只在校准/复位后变化, 平时隔很久才读一次
+            cv.Optional(CONF_BASE_INTERVAL, default="1h"): cv.positive_time_period_milliseconds,
+        }
+    ).extend(cv.polling_component_schema("20s")).extend(i2c.i2c_device_schema(0x2A))
+
+
+def final_validate_schema(name):
+    return i2c.final_validate_device_schema(name, max_frequency="100khz")
+
+
+async def register_acd(config, gas_key):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    await i2c.register_i2c_device(var, config)
+
+    if gas_key in config:
+        sens = await sensor.new_sensor(config[gas_key])
+        cg.add(var.set_gas_sensor(sens))
+    if CONF_TEMPERATURE in config:
+        sens = await sensor.new_sensor(config[CONF_TEMPERATURE])
+        cg.add(var.set_temperature_sensor(sens))
+    if CONF_BASE in config:
+        sens = await sensor.new_sensor(config[CONF_BASE])
+        cg.add(var.set_base_sensor(sens))
+    cg.add(var.set_base_interval(config[CONF_BASE_INTERVAL]))
+    return var
+
+
+def set_calibrate_mode_action_schema(component):
+    return automation.maybe_simple_id(
+        {
+            cv.Required(CONF_ID): cv.use_id(component),
+            cv.Required(CONF_MODE): cv.templatable(cv.boolean),
+        }
+    )
+
+
+async def set_calibrate_mode_action_to_code(config, action_id, template_arg, args):
+    paren = await cg.get_variable(config[CONF_ID])
+    var = cg.new_Pvariable(action_id, template_arg, paren)
+    mode = await cg.templatable(config[CONF_MODE], args, cg.bool_)
+    cg.add(var.set_mode(mode))
+    return var
+
+
+def calibrate_action_schema(component):
+    return automation.maybe_simple_id(
+        {
+            cv.Required(CONF_ID): cv.use_id(component),
+            cv.Required(CONF_BASE): cv.templatable(cv.positive_int),
+        }
+    )
+
+
+async def calibrate_action_to_code(config, action_id, template_arg, args):
+    paren = await cg.get_variable(config[CONF_ID])
+    var = cg.new_Pvariable(action_id, template_arg, paren)
+    base = await cg.templatable(config[CONF_BASE], args, cg.uint16)
+    cg.add(var.set_base(base))
+    return var
+
+
+def reset_action_schema(component):
+    return automation.maybe_simple_id(
+        {
+            cv.Required(CONF_ID): cv.use_id(component),
+        }
+    )
+
+
+async def reset_action_to_code(config, action_id, template_arg, args):
+    paren = await cg.get_variable(config[CONF_ID])
+    return cg.new_Pvariable(action_id, template_arg, paren)
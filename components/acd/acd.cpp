@@ -0,0 +1,141 @@
+#include "acd.h"
+#include "esphome/components/aosong_crc/aosong_crc.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace acd {
+
+static const char *const TAG = "acd";
+static const uint8_t READ_CMD[2] = {0x03, 0x00};            // 读浓度和温度
+static const uint8_t BASE_CMD[2] = {0x52, 0x04};            // 读/写校准基准值
+static const uint8_t RESET_CMD[2] = {0x52, 0x02};           // 恢复出厂设置
+static const uint8_t CALIBRATE_MODE_CMD[2] = {0x53, 0x06};  // 读/写校准模式
+static const uint8_t VERSION_CMD[2] = {0xD1, 0x00};         // 版本查询
+static const uint8_t SN_CMD[2] = {0xD2, 0x01};              // 编号查询
+
+void ACDComponent::setup() {
+  ESP_LOGCONFIG(TAG, "Running setup");
+  this->read_identity_(VERSION_CMD, this->version_);
+  this->read_identity_(SN_CMD, this->sn_);
+}
+
+void ACDComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "%s:\n"
+                "  Version: %s\n"
+                "  SN: %s", this->traits_.name, this->version_, this->sn_);
+  LOG_I2C_DEVICE(this);
+  LOG_UPDATE_INTERVAL(this);
+  LOG_SENSOR("  ", "GAS SENSOR", this->gas_sensor_);
+  LOG_SENSOR("  ", "TEMPERATURE SENSOR", this->temperature_sensor_);
+  LOG_SENSOR("  ", "BASE SENSOR", this->base_sensor_);
+  if (this->base_sensor_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  Base Interval: %" PRIu32 " ms", this->base_interval_);
+  }
+}
+
+void ACDComponent::update() {
+  uint8_t data[9];
+  if (!this->read_words_(READ_CMD, data, 3)) {
+    this->status_set_warning();
+    return;
+  }
+  if (this->gas_sensor_ != nullptr) {
+    uint32_t gas = ((uint32_t) data[0]) << 24 | ((uint32_t) data[1]) << 16 | ((uint32_t) data[3]) << 8 |
+                   ((uint32_t) data[4]);  // 解析浓度数据
+    this->gas_sensor_->publish_state(gas);
+  }
+  if (this->temperature_sensor_ != nullptr) {
+    int16_t temperature = ((int16_t) data[6]) << 8 | ((int16_t) data[7]);  // 解析温度数据
+    this->temperature_sensor_->publish_state(temperature);
+  }
+  this->status_clear_warning();
+  this->update_base_();
+}
+
+void ACDComponent::update_base_() {
+  if (this->base_sensor_ == nullptr) {
+    return;
+  }
+  uint32_t now = millis();
+  if (!this->base_dirty_ && now - this->last_base_ < this->base_interval_) {
+    return;
+  }
+  uint8_t data[3];
+  if (!this->read_words_(BASE_CMD, data, 1)) {
+    return;  // 下一次 update 再试
+  }
+  this->base_dirty_ = false;
+  this->last_base_ = now;
+  this->base_sensor_->publish_state(((uint16_t) data[0]) << 8 | data[1]);
+}
+
+void ACDComponent::set_calibrate_mode(bool auto_) {
+  if (!this->traits_.has_calibrate_mode) {
+    ESP_LOGW(TAG, "%s has no calibrate mode", this->traits_.name);
+    return;
+  }
+  uint8_t buffer[5] = {CALIBRATE_MODE_CMD[0], CALIBRATE_MODE_CMD[1], 0x00, (uint8_t) (auto_ ? 0x01 : 0x00), 0x00};
+  buffer[4] = aosong_crc::crc8(buffer, 4);  // 计算CRC
+  this->write(buffer, 5);                   // 写入校准模式
+}
+
+bool ACDComponent::get_calibrate_mode() {
+  uint8_t data[3];
+  if (!this->traits_.has_calibrate_mode || !this->read_words_(CALIBRATE_MODE_CMD, data, 1)) {
+    return false;
+  }
+  return data[1] != 0;  // 1 自动校准, 0 手动校准
+}
+
+void ACDComponent::calibrate(uint16_t base) {
+  uint8_t buffer[5] = {BASE_CMD[0], BASE_CMD[1], (uint8_t) (base >> 8), (uint8_t) (base & 0xFF), 0x00};
+  buffer[4] = aosong_crc::crc8(buffer, 4);  // 计算CRC
+  this->write(buffer, 5);                   // 写入校准数据
+  this->base_dirty_ = true;
+}
+
+uint16_t ACDComponent::read_base() {
+  uint8_t data[3];
+  if (!this->read_words_(BASE_CMD, data, 1)) {
+    return 0;
+  }
+  return ((uint16_t) data[0]) << 8 | data[1];  // 解析校准值
+}
+
+void ACDComponent::reset() {
+  uint8_t reset_cmd[3] = {RESET_CMD[0], RESET_CMD[1], 0x00};
+  this->write(reset_cmd, 3);  // 写入重置命令
+  this->base_dirty_ = true;
+  if (!this->read_words_(RESET_CMD, reset_cmd, 1)) {
+    return;
+  }
+  if (reset_cmd[1] != 0x01) {
+    ESP_LOGW(TAG, "%s reset failed: expected 0x01, got %02X", this->traits_.name, reset_cmd[1]);
+  }
+}
+
+bool ACDComponent::read_words_(const uint8_t *cmd, uint8_t *data, size_t words) {
+  if (this->write(cmd, 2) != i2c::ERROR_OK || this->read(data, words * 3) != i2c::ERROR_OK) {
+    ESP_LOGW(TAG, "%s command %02X%02X failed", this->traits_.name, cmd[0], cmd[1]);
+    return false;
+  }
+  int bad = aosong_crc::check_words(data, words);
+  if (bad >= 0) {
+    ESP_LOGW(TAG, "%s CRC error in word %d", this->traits_.name, bad);
+    return false;
+  }
+  return true;
+}
+
+void ACDComponent::read_identity_(const uint8_t *cmd, char *buffer) {
+  // 10 字节 ASCII, 没有 CRC
+  if (this->write(cmd, 2) != i2c::ERROR_OK || this->read((uint8_t *) buffer, 10) != i2c::ERROR_OK) {
+    buffer[0] = '\0';
+    return;
+  }
+  buffer[10] = '\0';
+}
+
+}  // namespace acd
+}  // namespace esphome
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "esphome/components/i2c/i2c.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/core/automation.h"
+#include "esphome/core/component.h"
+
+namespace esphome {
+namespace acd {
+
+// 各型号之间的差异, 命令和帧格式都相同
+// 型号目录里用同名静态成员写一个 traits 类型, 交给 ACDChip
+struct ACDTraits {
+  const char *name;         // 日志里显示的型号
+  bool has_calibrate_mode;  // 是否支持切换自动/手动校准
+};
+
+// 读写流程不是模板, 同一固件里用多个型号时只有一份代码
+class ACDComponent : public PollingComponent, public i2c::I2CDevice {
+ public:
+  explicit ACDComponent(const ACDTraits &traits) : traits_(traits) {}
+  float get_setup_priority() const override { return setup_priority::DATA; }
+  void setup() override;
+  void dump_config() override;
+  void update() override;
+  void set_gas_sensor(sensor::Sensor *gas_sensor) { this->gas_sensor_ = gas_sensor; }
+  void set_temperature_sensor(sensor::Sensor *temperature_sensor) { this->temperature_sensor_ = temperature_sensor; }
+  void set_base_sensor(sensor::Sensor *base_sensor) { this->base_sensor_ = base_sensor; }
+  void set_base_interval(uint32_t base_interval) { this->base_interval_ = base_interval; }
+
+  void set_calibrate_mode(bool auto_);
+  bool get_calibrate_mode();
+  void calibrate(uint16_t base);
+  uint16_t read_base();
+  void reset();
+
+ protected:
+  // 发送 2 字节命令, 读回 words 组 (2 字节 + CRC), 任一组 CRC 错误返回 false
+  bool read_words_(const uint8_t *cmd, uint8_t *data, size_t words);
+  void read_identity_(const uint8_t *cmd, char *buffer);
+  void update_base_();
+
+  const ACDTraits traits_;
+  sensor::Sensor *gas_sensor_{nullptr};
+  sensor::Sensor *temperature_sensor_{nullptr};
+  sensor::Sensor *base_sensor_{nullptr};
+  // 版本和编号在 setup 时读一次
+  char version_[11]{};
+  char sn_[11]{};
+  // 基准值只在校准/复位之后或者每隔 base_interval_ 读一次
+  uint32_t base_interval_{3600000};
+  uint32_t last_base_{0};
+  bool base_dirty_{true};
+};
+
+// 每个型号只是换一组 traits
+template<typename T> class ACDChip : public ACDComponent {
+ public:
+  ACDChip() : ACDComponent({T::NAME, T::HAS_CALIBRATE_MODE}) {}
+};
+
+template<typename... Ts> class ACDSetCalibrateModeAction : public Action<Ts...> {
+ public:
+  ACDSetCalibrateModeAction(ACDComponent *acd) : acd_(acd) {}
+  TEMPLATABLE_VALUE(bool, mode)
+  void play(const Ts &...x) override { this->acd_->set_calibrate_mode(this->mode_.value(x...)); }
+
+ protected:
+  ACDComponent *acd_;
+};
+
+template<typename... Ts> class ACDCalibrateAction : public Action<Ts...> {
+ public:
+  ACDCalibrateAction(ACDComponent *acd) : acd_(acd) {}
+  TEMPLATABLE_VALUE(uint16_t, base)
+  void play(const Ts &...x) override { this->acd_->calibrate(this->base_.value(x...)); }
+
+ protected:
+  ACDComponent *acd_;
+};
+
+template<typename... Ts> class ACDResetAction : public Action<Ts...> {
+ public:
+  ACDResetAction(ACDComponent *acd) : acd_(acd) {}
+  void play(const Ts &...x) override { this->acd_->reset(); }
+
+ protected:
+  ACDComponent *acd_;
+};
+
+}  // namespace acd
+}  // namespace esphome
@@ -1,4 +1,5 @@
 #include "afs01.h"
+#include "esphome/components/aosong_crc/aosong_crc.h"
 #include "esphome/components/i2c/i2c.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
@@ -10,21 +11,6 @@ static const char *const TAG = "afs01";
 static const uint8_t GET_DATA_CMD[2] = {0x10, 0x00};  // Get sensor data command
 static const uint8_t GET_ID_CMD[2] = {0x31, 0xAE};  // Get sensor ID command
 
-uint8_t afs01_crc8(const uint8_t *dat, uint8_t size) {
-  uint8_t crc = 0xFF, i;
-  for (uint8_t b = 0; b < size; b++) {
-    crc ^= (dat[b]);
-    for (i = 0; i < 8; i++) {
-      if (crc & 0x80) {
-        crc = (crc << 1) ^ 0x31;
-      } else {
-        crc <<= 1;
-      }
-    }
-  }
-  return crc;
-}
-
 void AFS01Component::setup() { ESP_LOGCONFIG(TAG, "Running setup"); }
 
 void AFS01Component::dump_config() {
@@ -38,7 +24,7 @@ void AFS01Component::update() {
   this->write(GET_DATA_CMD, 2);
   uint8_t data[3];
   this->read(data, 3);
-  uint8_t crc = afs01_crc8(data, 2);
+  uint8_t crc = aosong_crc::crc8(data, 2);
   if (crc != data[2]) {
     ESP_LOGW(TAG, "AFS01 CRC error: expected %02X, got %02X", crc, data[2]);
     this->status_set_warning();
@@ -55,15 +41,9 @@ uint32_t AFS01Component::unique_id() {
   this->write(GET_ID_CMD, 2);
   uint8_t data[6];
   this->read(data, 6);
-  uint8_t crc = afs01_crc8(data, 2);
-  if(data[2] != crc) {
-    ESP_LOGW(TAG, "AFS01 CRC error: expected %02X, got %02X", crc, data[2]);
-    this->status_set_warning();
-    return 0;  // CRC error
-  }
-  crc = afs01_crc8((uint8_t*)data+3, 2);
-  if(data[5] != crc) {
-    ESP_LOGW(TAG, "AFS01 CRC error: expected %02X, got %02X", crc, data[5]);
+  int bad = aosong_crc::check_words(data, 2);
+  if (bad >= 0) {
+    ESP_LOGW(TAG, "AFS01 CRC error in word %d", bad);
     this->status_set_warning();
     return 0;  // CRC error
   }
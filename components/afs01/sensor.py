@@ -8,6 +8,7 @@ from esphome.const import (
 
 CODEOWNERS = ["@synodriver"]
 DEPENDENCIES = ["i2c"]
+AUTO_LOAD = ["aosong_crc"]
 
 afs01 = cg.esphome_ns.namespace("afs01")
 AFS01Component = afs01.class_("AFS01Component", cg.PollingComponent, i2c.I2CDevice)
@@ -20,36 +20,49 @@ void AGR12Component::dump_config() {
   LOG_SENSOR("  ", "Pressure Sensor", this->pressure_sensor_);
 }
 
-void AGR12Component::update() {
-  if (this->pressure_sensor_ != nullptr) {
-    this->write(READ_CMD, 2);  // 发送读取命令
-    delay(80);  // 等待传感器响应
-    // 读取压力传感器数据
-    uint8_t data[3];
-    this->read(data, 3);
-    uint8_t crc = data[0] ^ data[1];
-    if(crc!=data[2]) {
-      ESP_LOGW(TAG, "AGR12 CRC error: expected %02X, got %02X", crc, data[2]);
-      this->status_set_warning();
-      return;  // CRC错误
-    }
-    int32_t pressure = ((int32_t)data[0] << 8) | ((int32_t)data[1]);
-    float frac = 10.0f;
-    if (this->type_==AGR12) {
-      frac = 10.0f;
-    } else {
-      frac = 100.0f;
-    }
-
-    if (data[0] & 0x80) {
-      // 负压
-      pressure = pressure & 0x7FFF;  // 清除符号位
-      this->pressure_sensor_->publish_state((float)(pressure-32768) / frac);
-    } else {
-      this->pressure_sensor_->publish_state((float) pressure / frac);
-    }
-    this->status_clear_warning();
+int32_t AGR12Component::start_measurement_() {
+  if (this->pressure_sensor_ == nullptr) {
+    return -1;
   }
+  if (this->write(READ_CMD, 2) != i2c::ERROR_OK) {  // 发送读取命令
+    ESP_LOGW(TAG, "AGR12 trigger failed");
+    this->status_set_warning();
+    return -1;
+  }
+  return 80;  // 等待传感器响应
+}
+
+i2c_measure::MeasureStep AGR12Component::read_measurement_() {
+  // 读取压力传感器数据
+  uint8_t data[3];
+  if (this->read(data, 3) != i2c::ERROR_OK) {
+    ESP_LOGW(TAG, "AGR12 read failed");
+    this->status_set_warning();
+    return i2c_measure::MEASURE_DONE;
+  }
+  uint8_t crc = data[0] ^ data[1];
+  if(crc!=data[2]) {
+    ESP_LOGW(TAG, "AGR12 CRC error: expected %02X, got %02X", crc, data[2]);
+    this->status_set_warning();
+    return i2c_measure::MEASURE_DONE;  // CRC错误
+  }
+  int32_t pressure = ((int32_t)data[0] << 8) | ((int32_t)data[1]);
+  float frac = 10.0f;
+  if (this->type_==AGR12) {
+    frac = 10.0f;
+  } else {
+    frac = 100.0f;
+  }
+
+  if (data[0] & 0x80) {
+    // 负压
+    pressure = pressure & 0x7FFF;  // 清除符号位
+    this->pressure_sensor_->publish_state((float)(pressure-32768) / frac);
+  } else {
+    this->pressure_sensor_->publish_state((float) pressure / frac);
+  }
+  this->status_clear_warning();
+  return i2c_measure::MEASURE_DONE;
 }
 
 }
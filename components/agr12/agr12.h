@@ -7,6 +7,7 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
+#include "esphome/components/i2c_measure/i2c_measure.h"
 
 namespace esphome {
 namespace agr12 {
@@ -16,17 +17,19 @@ enum AGR_TYPE: uint8_t {
   APR5852,
 };
 
-class AGR12Component : public PollingComponent, public i2c::I2CDevice {
+class AGR12Component : public i2c_measure::TriggeredPollingComponent, public i2c::I2CDevice {
  public:
   float get_setup_priority() const override { return setup_priority::DATA; }
   void setup() override;
   void dump_config() override;
-  void update() override;
 
   void set_pressure_sensor(sensor::Sensor *pressure_sensor) { this->pressure_sensor_ = pressure_sensor; }
   void set_type(AGR_TYPE type_) { this->type_ = type_; }
 
  protected:
+  int32_t start_measurement_() override;
+  i2c_measure::MeasureStep read_measurement_() override;
+
   sensor::Sensor *pressure_sensor_{nullptr};
   AGR_TYPE type_;
 };
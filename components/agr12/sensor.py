@@ -1,6 +1,7 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import sensor, i2c
+from esphome.components.i2c_measure import TriggeredPollingComponent
 from esphome.const import (
     STATE_CLASS_MEASUREMENT,
     CONF_ID, CONF_PRESSURE, DEVICE_CLASS_PRESSURE, CONF_TYPE,
@@ -8,9 +9,10 @@ from esphome.const import (
 
 CODEOWNERS = ["@synodriver"]
 DEPENDENCIES = ["i2c"]
+AUTO_LOAD = ["i2c_measure"]
 
 agr12 = cg.esphome_ns.namespace("agr12")
-AGR12Component = agr12.class_("AGR12Component", cg.PollingComponent, i2c.I2CDevice)
+AGR12Component = agr12.class_("AGR12Component", TriggeredPollingComponent, i2c.I2CDevice)
 
 AGR_TYPE = agr12.enum("AGR_TYPE")
 AGR_TYPE_OPTIONS = {
@@ -0,0 +1,72 @@
+# AGS 系列气体传感器的公共驱动, 各型号只提供 traits 和气体传感器的 schema
+# 寄存器和 CRC 见各型号目录下的说明书
+from esphome import automation
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor, i2c
+from esphome.const import (
+    CONF_ID,
+    CONF_CURRENT_RESISTOR,
+    CONF_MODE,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_OHM, ICON_RESTART,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+)
+
+CODEOWNERS = ["@synodriver"]
+DEPENDENCIES = ["i2c"]
+AUTO_LOAD = ["aosong_crc"]
+
+ags_ns = cg.esphome_ns.namespace("ags")
+AGSComponent = ags_ns.class_("AGSComponent", cg.PollingComponent, i2c.I2CDevice)
+
+
+def ags_schema(component, gas_key, gas_schema):
+    return cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(component),
+            cv.Optional(gas_key): gas_schema,
+            cv.Optional(CONF_CURRENT_RESISTOR): sensor.sensor_schema(
+                unit_of_measurement=UNIT_OHM,
+                icon=ICON_RESTART,
+                accuracy_decimals=0,
+                state_class=STATE_CLASS_MEASUREMENT,
+                entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+            ),
+        }
+    ).extend(cv.polling_component_schema("20s")).extend(i2c.i2c_device_schema(0x1A))
+
+
+def final_validate_schema(name):
+    return i2c.final_validate_device_schema(name, max_frequency="100khz")
+
+
+async def register_ags(config, gas_key):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    await i2c.register_i2c_device(var, config)
+
+    if gas_key in config:
+        sens = await sensor.new_sensor(config[gas_key])
+        cg.add(var.set_gas_sensor(sens))
+    if CONF_CURRENT_RESISTOR in config:
+        sens = await sensor.new_sensor(config[CONF_CURRENT_RESISTOR])
+        cg.add(var.set_resistor_sensor(sens))
+    return var
+
+
+def calibrate_action_schema(component):
+    return automation.maybe_simple_id(
+        {
+            cv.Required(CONF_ID): cv.use_id(component),
+            cv.Required(CONF_MODE): cv.templatable(cv.positive_int),
+        }
+    )
+
+
+async def calibrate_action_to_code(config, action_id, template_arg, args):
+    paren = await cg.get_variable(config[CONF_ID])
+    var = cg.new_Pvariable(action_id, template_arg, paren)
+    mode = await cg.templatable(config[CONF_MODE], args, cg.uint16)
+    cg.add(var.set_mode(mode))
+    return var
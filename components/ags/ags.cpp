@@ -0,0 +1,77 @@
+#include "ags.h"
+#include "esphome/components/aosong_crc/aosong_crc.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace ags {
+
+static const char *const TAG = "ags";
+static const uint8_t REG_DATA = 0x00;       // 浓度
+static const uint8_t REG_CALIBRATE = 0x01;  // 校准寄存器地址
+static const uint8_t REG_VERSION = 0x11;    // 版本寄存器地址
+static const uint8_t REG_RESISTER = 0x20;   // 阻值地址
+
+void AGSComponent::setup() {
+  ESP_LOGCONFIG(TAG, "Running setup");
+  uint8_t data[5];
+  if (this->read_register_(REG_VERSION, data)) {
+    this->version_ = ((int32_t) data[0] << 24) | ((int32_t) data[1] << 16) | ((int32_t) data[2] << 8) | data[3];
+  }
+}
+
+void AGSComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "%s:\n"
+                "  Version: %d\n", this->traits_.name, (int) this->version_);
+  LOG_I2C_DEVICE(this);
+  LOG_UPDATE_INTERVAL(this);
+  LOG_SENSOR("  ", "GAS SENSOR", this->gas_sensor_);
+  LOG_SENSOR("  ", "RESISTOR SENSOR", this->resistor_sensor_);
+}
+
+void AGSComponent::update() {
+  uint8_t data[5];
+  if (this->gas_sensor_ != nullptr) {
+    if (!this->read_register_(REG_DATA, data)) {
+      this->status_set_warning();
+      return;
+    }
+    if (data[0] & this->traits_.not_ready_mask) {
+      ESP_LOGW(TAG, "%s sensor not ready", this->traits_.name);
+      return;  // Sensor not ready
+    }
+    uint32_t gas = ((uint32_t) data[1] << 16) | ((uint32_t) data[2] << 8) | data[3];
+    this->gas_sensor_->publish_state(gas * this->traits_.scale);
+  }
+  if (this->resistor_sensor_ != nullptr) {
+    if (!this->read_register_(REG_RESISTER, data)) {
+      this->status_set_warning();
+      return;
+    }
+    // https://github.com/RobTillaart/Arduino/blob/48a03abc5948770150802e773848eb8266718969/libraries/AGS3871/AGS3871.cpp
+    uint32_t resistor = ((uint32_t) data[0] << 16) | ((uint32_t) data[1] << 8) | data[2];
+    this->resistor_sensor_->publish_state(resistor * this->traits_.resistor_scale);
+  }
+  this->status_clear_warning();
+}
+
+void AGSComponent::calibrate(uint16_t mode) {
+  uint8_t data[5] = {0x00, 0x0C, (uint8_t) ((mode >> 8) & 0xFF), (uint8_t) (mode & 0xFF), 0x00};
+  data[4] = aosong_crc::crc8(data, 4);
+  this->write_register(REG_CALIBRATE, data, 5);  // 写入校准寄存器
+}
+
+bool AGSComponent::read_register_(uint8_t reg, uint8_t *data) {
+  if (this->write(&reg, 1) != i2c::ERROR_OK || this->read(data, 5) != i2c::ERROR_OK) {
+    ESP_LOGW(TAG, "%s read register 0x%02X failed", this->traits_.name, reg);
+    return false;
+  }
+  uint8_t crc = aosong_crc::crc8(data, 4);
+  if (crc != data[4]) {
+    ESP_LOGW(TAG, "%s CRC error: expected %02X, got %02X", this->traits_.name, crc, data[4]);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace ags
+}  // namespace esphome
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "esphome/components/i2c/i2c.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/core/automation.h"
+#include "esphome/core/component.h"
+
+namespace esphome {
+namespace ags {
+
+// 各型号之间的差异, 寄存器和读写流程都相同
+// 型号目录里用同名静态成员写一个 traits 类型, 交给 AGSChip
+struct AGSTraits {
+  const char *name;        // 日志里显示的型号
+  float scale;             // 浓度原始值 -> 发布的单位
+  uint8_t not_ready_mask;  // 状态字节里表示预热/未就绪的位
+  float resistor_scale;    // 阻值原始值 -> 欧姆
+};
+
+// 读写流程不是模板, 同一固件里用多个型号时只有一份代码
+class AGSComponent : public PollingComponent, public i2c::I2CDevice {
+ public:
+  explicit AGSComponent(const AGSTraits &traits) : traits_(traits) {}
+  float get_setup_priority() const override { return setup_priority::DATA; }
+  void setup() override;
+  void dump_config() override;
+  void update() override;
+  void set_gas_sensor(sensor::Sensor *gas_sensor) { this->gas_sensor_ = gas_sensor; }
+  void set_resistor_sensor(sensor::Sensor *resistor_sensor) { this->resistor_sensor_ = resistor_sensor; }
+  void calibrate(uint16_t mode);
+
+ protected:
+  // 读 5 字节 (4 字节数据 + CRC), 校验失败返回 false
+  bool read_register_(uint8_t reg, uint8_t *data);
+
+  const AGSTraits traits_;
+  sensor::Sensor *gas_sensor_{nullptr};
+  sensor::Sensor *resistor_sensor_{nullptr};
+  int32_t version_{-1};  // setup 时读一次
+};
+
+// 每个型号只是换一组 traits
+template<typename T> class AGSChip : public AGSComponent {
+ public:
+  AGSChip() : AGSComponent({T::NAME, T::SCALE, T::NOT_READY_MASK, T::RESISTOR_SCALE}) {}
+};
+
+template<typename... Ts> class AGSCalibrateAction : public Action<Ts...> {
+ public:
+  AGSCalibrateAction(AGSComponent *ags) : ags_(ags) {}
+  TEMPLATABLE_VALUE(uint16_t, mode)
+  void play(const Ts &...x) override { this->ags_->calibrate(this->mode_.value(x...)); }
+
+ protected:
+  AGSComponent *ags_;
+};
+
+}  // namespace ags
+}  // namespace esphome
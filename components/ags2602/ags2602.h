@@ -1,39 +1,19 @@
 #pragma once
 
-#include <vector>
-#include "esphome/components/i2c/i2c.h"
-#include "esphome/components/sensor/sensor.h"
-#include "esphome/core/automation.h"
-#include "esphome/core/component.h"
-#include "esphome/core/hal.h"
+#include "esphome/components/ags/ags.h"
 
 namespace esphome {
 namespace ags2602 {
 
-class AGS2602Component : public PollingComponent, public i2c::I2CDevice {
- public:
-  float get_setup_priority() const override { return setup_priority::DATA; }
-  void setup() override;
-  void dump_config() override;
-  void update() override;
-  void set_tvoc_sensor(sensor::Sensor *tvoc_sensor) { this->tvoc_sensor_ = tvoc_sensor; }
-  void set_resistor_sensor(sensor::Sensor *resistor_sensor) { this->resistor_sensor_ = resistor_sensor; }
-  void calibrate(uint16_t mode);
- protected:
-  sensor::Sensor *tvoc_sensor_{nullptr};
-  sensor::Sensor *resistor_sensor_{nullptr};
-  int get_version();
+struct AGS2602Traits {
+  static constexpr const char *NAME = "AGS2602";
+  static constexpr float SCALE = 1.0f;
+  static constexpr uint8_t NOT_READY_MASK = 0x01;  // 状态字节 bit0: 预热中
+  static constexpr float RESISTOR_SCALE = 10.0f;   // 阻值单位 0.1kΩ
 };
 
-template<typename... Ts> class AGS2602CalibrateAction : public Action<Ts...> {
- public:
-  AGS2602CalibrateAction(AGS2602Component *ags2602) : ags2602_(ags2602) {}
-  TEMPLATABLE_VALUE(uint16_t, mode)
-  void play(const Ts &...x) override { this->ags2602_->calibrate(this->mode_.value(x...)); }
+using AGS2602Component = ags::AGSChip<AGS2602Traits>;
+template<typename... Ts> using AGS2602CalibrateAction = ags::AGSCalibrateAction<Ts...>;
 
- protected:
-  AGS2602Component *ags2602_;
-};
-
-} // esphome
-} // ags2602
\ No newline at end of file
+}  // namespace ags2602
+}  // namespace esphome
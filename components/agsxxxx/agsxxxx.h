@@ -1,41 +1,29 @@
 #pragma once
 
-#include <vector>
-#include "esphome/components/i2c/i2c.h"
-#include "esphome/components/sensor/sensor.h"
-#include "esphome/core/automation.h"
-#include "esphome/core/component.h"
-#include "esphome/core/hal.h"
+#include <string>
+#include "esphome/components/ags/ags.h"
 
 namespace esphome {
 namespace agsxxxx {
 
-class AGSXXXXComponent : public PollingComponent, public i2c::I2CDevice {
- public:
-  float get_setup_priority() const override { return setup_priority::DATA; }
-  void setup() override;
-  void dump_config() override;
-  void update() override;
-  void set_gas_sensor(sensor::Sensor *gas_sensor) { this->gas_sensor_ = gas_sensor; }
-  void set_type(std::string type_) { this->type_ = type_; }
-  void set_resistor_sensor(sensor::Sensor *resistor_sensor) { this->resistor_sensor_ = resistor_sensor; }
-  void calibrate(uint16_t mode);
- protected:
-  sensor::Sensor *gas_sensor_{nullptr};
-  sensor::Sensor *resistor_sensor_{nullptr};
-  std::string type_;
-  int get_version();
+// 通用型号: 气体种类由配置里的 type 给出, 只用于日志
+struct AGSXXXXTraits {
+  static constexpr const char *NAME = "AGSXXXX";
+  static constexpr float SCALE = 1.0f;
+  static constexpr uint8_t NOT_READY_MASK = 0x01;
+  static constexpr float RESISTOR_SCALE = 10.0f;
 };
 
-template<typename... Ts> class AGSXXXXCalibrateAction : public Action<Ts...> {
+class AGSXXXXComponent : public ags::AGSChip<AGSXXXXTraits> {
  public:
-  AGSXXXXCalibrateAction(AGSXXXXComponent *agsxxxx) : agsxxxx_(agsxxxx) {}
-  TEMPLATABLE_VALUE(uint16_t, mode)
-  void play(const Ts &...x) override { this->agsxxxx_->calibrate(this->mode_.value(x...)); }
+  void dump_config() override;
+  void set_type(std::string type) { this->type_ = std::move(type); }
 
  protected:
-  AGSXXXXComponent *agsxxxx_;
+  std::string type_;
 };
 
-} // esphome
-} // agsxxxx
\ No newline at end of file
+template<typename... Ts> using AGSXXXXCalibrateAction = ags::AGSCalibrateAction<Ts...>;
+
+}  // namespace agsxxxx
+}  // namespace esphome
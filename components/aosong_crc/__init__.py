@@ -0,0 +1,2 @@
+# 奥松(Aosong)系列 I2C 传感器共用的 CRC-8 校验, 只有头文件, 由各传感器 AUTO_LOAD
+CODEOWNERS = ["@synodriver"]
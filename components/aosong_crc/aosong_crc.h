@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace aosong_crc {
+
+// CRC-8: 多项式 0x31, 初值 0xFF, 不反转, 结果不异或
+static constexpr uint8_t CRC8_POLYNOMIAL = 0x31;
+static constexpr uint8_t CRC8_INIT = 0xFF;
+
+constexpr std::array<uint8_t, 256> make_crc8_table() {
+  std::array<uint8_t, 256> table{};
+  for (int i = 0; i < 256; i++) {
+    uint8_t crc = i;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x80) ? (uint8_t) ((crc << 1) ^ CRC8_POLYNOMIAL) : (uint8_t) (crc << 1);
+    }
+    table[i] = crc;
+  }
+  return table;
+}
+
+// 编译期生成, 所有驱动共用一份
+inline constexpr std::array<uint8_t, 256> CRC8_TABLE = make_crc8_table();
+
+inline uint8_t crc8(const uint8_t *data, size_t size) {
+  uint8_t crc = CRC8_INIT;
+  for (size_t i = 0; i < size; i++) {
+    crc = CRC8_TABLE[crc ^ data[i]];
+  }
+  return crc;
+}
+
+// 校验连续 words 组 [高字节, 低字节, CRC], 返回第一个出错组的序号, 全部正确返回 -1
+inline int check_words(const uint8_t *data, size_t words) {
+  for (size_t i = 0; i < words; i++, data += 3) {
+    if (CRC8_TABLE[CRC8_TABLE[CRC8_INIT ^ data[0]] ^ data[1]] != data[2]) {
+      return (int) i;
+    }
+  }
+  return -1;
+}
+
+}  // namespace aosong_crc
+}  // namespace esphome
@@ -1,4 +1,5 @@
 #include "apm10.h"
+#include "esphome/components/aosong_crc/aosong_crc.h"
 #include "esphome/components/i2c/i2c.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
@@ -12,21 +13,6 @@ static const uint8_t STOP_MEASUREMENT_CMD[2] = {0x01, 0x04};
 static const uint8_t READ_CMD[2] = {0x03, 0x00};  // Read command
 
 
-uint8_t apm10_crc8(const uint8_t *dat, uint8_t size) {
-  uint8_t crc = 0xFF, i;
-  for (uint8_t b = 0; b < size; b++) {
-    crc ^= (dat[b]);
-    for (i = 0; i < 8; i++) {
-      if (crc & 0x80) {
-        crc = (crc << 1) ^ 0x31;
-      } else {
-        crc <<= 1;
-      }
-    }
-  }
-  return crc;
-}
-
 void APM10Component::setup() {
   ESP_LOGCONFIG(TAG, "Running setup");
   this->start_measurement();
@@ -52,27 +38,18 @@ void APM10Component::update() {
   this->write(READ_CMD, 2);
   uint8_t data[30];
   this->read(data, 30);
-  uint8_t crc;
-  crc = apm10_crc8(data, 2);
-  if(crc!=data[2]) {
-    ESP_LOGW(TAG, "APM10 CRC error: expected %02X, got %02X", crc, data[2]);
-    return;  // CRC error
-  }
-  crc = apm10_crc8((uint8_t *)data + 3, 2);
-  if (crc!= data[5]) {
-    ESP_LOGW(TAG, "APM10 CRC error: expected %02X, got %02X", crc, data[5]);
-    return;  // CRC error
-  }
-  if(this->type_ == APM10_TYPE_3000) {
-    crc = apm10_crc8((uint8_t *)data + 6, 2);
-    if(crc!=data[8]) {
-      ESP_LOGW(TAG, "APM10 CRC error: expected %02X, got %02X", crc, data[8]);
-      return;  // CRC error
+  int bad;
+  if (this->type_ == APM10_TYPE_3000) {
+    bad = aosong_crc::check_words(data, 4);
+  } else {
+    // 其他型号没有 PM4.0, 跳过第 3 组
+    bad = aosong_crc::check_words(data, 2);
+    if (bad < 0 && aosong_crc::check_words(data + 9, 1) >= 0) {
+      bad = 3;
     }
   }
-  crc = apm10_crc8((uint8_t *)data + 9, 2);
-  if (crc != data[11]) {
-    ESP_LOGW(TAG, "APM10 CRC error: expected %02X, got %02X", crc, data[11]);
+  if (bad >= 0) {
+    ESP_LOGW(TAG, "APM10 CRC error in word %d", bad);
     return;  // CRC error
   }
   uint16_t pm1_0 = (((uint16_t)data[0]) << 8) | ((uint16_t)data[1]);  // PM1.0
@@ -17,6 +17,7 @@ from esphome.const import (
 
 CODEOWNERS = ["@synodriver"]
 DEPENDENCIES = ["i2c"]
+AUTO_LOAD = ["aosong_crc"]
 
 apm10 = cg.esphome_ns.namespace("apm10")
 APM10Component = apm10.class_("APM10Component", cg.PollingComponent, i2c.I2CDevice)
@@ -3,7 +3,7 @@ from esphome import automation
 import esphome.config_validation as cv
 from esphome.components import uart
 from esphome.const import (
-    CONF_ID,
+    CONF_ID, CONF_TRIGGER_ID, CONF_UART_ID,
 )
 
 CODEOWNERS = ["@synodriver"]
@@ -11,14 +11,35 @@ DEPENDENCIES = ["uart"]
 MULTI_CONF = True
 
 CONF_AS201_ID = "as201_id"
+CONF_EXPORT = "export"
+CONF_BATCH_SIZE = "batch_size"
+CONF_ON_BATCH = "on_batch"
+
+# 与 as201.h 中 AS201_EXPORT_MAX_BATCH 一致
+EXPORT_MAX_BATCH = 32
 
 as201 = cg.esphome_ns.namespace("as201")
 AS201Component = as201.class_("AS201Component", cg.Component, uart.UARTDevice)
+AS201BatchTrigger = as201.class_(
+    "AS201BatchTrigger", automation.Trigger.template(cg.std_vector.template(cg.uint8))
+)
 
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
             cv.GenerateID(): cv.declare_id(AS201Component),
+            # 原始数据打包成二进制批量导出, 写到另一个串口或者交给 on_batch 处理
+            cv.Optional(CONF_EXPORT): cv.Schema(
+                {
+                    cv.Optional(CONF_BATCH_SIZE, default=16): cv.int_range(min=1, max=EXPORT_MAX_BATCH),
+                    cv.Optional(CONF_UART_ID): cv.use_id(uart.UARTComponent),
+                    cv.Optional(CONF_ON_BATCH): automation.validate_automation(
+                        {
+                            cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(AS201BatchTrigger),
+                        }
+                    ),
+                }
+            ),
         }
     )
     .extend(cv.COMPONENT_SCHEMA)
@@ -38,6 +59,15 @@ async def to_code(config):
     await cg.register_component(var, config)
     await uart.register_uart_device(var, config)
 
+    if export_config := config.get(CONF_EXPORT):
+        cg.add(var.set_export_batch_size(export_config[CONF_BATCH_SIZE]))
+        if CONF_UART_ID in export_config:
+            export_uart = await cg.get_variable(export_config[CONF_UART_ID])
+            cg.add(var.set_export_uart(export_uart))
+        for conf in export_config.get(CONF_ON_BATCH, []):
+            trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
+            await automation.build_automation(trigger, [(cg.std_vector.template(cg.uint8), "x")], conf)
+
 GetDataOnceAction = as201.class_("GetDataOnceAction", automation.Action)
 AS201_GETDATAONCE_SCHEMA = automation.maybe_simple_id(
     {
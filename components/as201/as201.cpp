@@ -1,5 +1,8 @@
 #include "as201.h"
+#include <algorithm>
 #include <bitset>
+#include <cmath>
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -9,9 +12,24 @@ static const char *const TAG = "as201";
 
 static uint8_t AS201_CMD_HEAD[2] = {0xFA, 0xFB};
 static uint8_t AS201_CMD_TAIL[2] = {0xFC, 0xFD};
+static const uint8_t AS201_DATA_FRAME_LEN = 45;  // cmd + type + 42 字节数据 + checksum
+// 每组第一个通道, 按 AS201Group 排列, 最后一项是通道总数
+static const uint8_t AS201_GROUP_FIRST[AS201_GROUP_COUNT + 1] = {
+    AS201_ACCEL_X, AS201_GYRO_X, AS201_ANGLE_X, AS201_FIELD_STRENGTH_X, AS201_Q0,
+    AS201_TEMPERATURE, AS201_PRESSURE, AS201_HEIGHT, AS201_CHANNEL_COUNT,
+};
+static const char *const AS201_GROUP_NAMES[AS201_GROUP_COUNT] = {
+    "accel", "gyro", "angle", "field_strength", "quaternion", "temperature", "pressure", "height",
+};
+static const char *const AS201_AGGREGATE_NAMES[] = {"mean", "min", "max", "last"};
 
 void AS201Component::setup() {
   ESP_LOGCONFIG(TAG, "Setting up AS201...");
+  this->published_.fill(NAN);
+  this->vibration_.setup();
+  if (this->export_batch_size_ > 0) {
+    this->export_buffer_.resize(AS201_EXPORT_HEADER_SIZE + this->export_batch_size_ * AS201_EXPORT_SAMPLE_SIZE);
+  }
   this->version();
   this->get_install_params();
 #ifdef USE_SELECT
@@ -24,81 +42,106 @@ void AS201Component::setup() {
 
 void AS201Component::dump_config() {
   ESP_LOGCONFIG(TAG, "AS201:");
-  LOG_SENSOR(" ", "Accel X", this->accel_x_sensor_);
-  LOG_SENSOR(" ", "Accel Y", this->accel_y_sensor_);
-  LOG_SENSOR(" ", "Accel Z", this->accel_z_sensor_);
-  LOG_SENSOR(" ", "Gyro X", this->gyro_x_sensor_);
-  LOG_SENSOR(" ", "Gyro Y", this->gyro_y_sensor_);
-  LOG_SENSOR(" ", "Gyro Z", this->gyro_z_sensor_);
-  LOG_SENSOR(" ", "Angle X", this->angle_x_sensor_);
-  LOG_SENSOR(" ", "Angle Y", this->angle_y_sensor_);
-  LOG_SENSOR(" ", "Angle Z", this->angle_z_sensor_);
-  LOG_SENSOR(" ", "Field Strength X", this->field_strength_x_sensor_);
-  LOG_SENSOR(" ", "Field Strength Y", this->field_strength_y_sensor_);
-  LOG_SENSOR(" ", "Field Strength Z", this->field_strength_z_sensor_);
-  LOG_SENSOR(" ", "Q0", this->q0_sensor_);
-  LOG_SENSOR(" ", "Q1", this->q1_sensor_);
-  LOG_SENSOR(" ", "Q2", this->q2_sensor_);
-  LOG_SENSOR(" ", "Q3", this->q3_sensor_);
-  LOG_SENSOR(" ", "Temperature", this->temperature_sensor_);
-  LOG_SENSOR(" ", "Pressure", this->pressure_sensor_);
-  LOG_SENSOR(" ", "Height", this->height_sensor_);
+  LOG_SENSOR(" ", "Accel X", this->sensors_[AS201_ACCEL_X]);
+  LOG_SENSOR(" ", "Accel Y", this->sensors_[AS201_ACCEL_Y]);
+  LOG_SENSOR(" ", "Accel Z", this->sensors_[AS201_ACCEL_Z]);
+  LOG_SENSOR(" ", "Gyro X", this->sensors_[AS201_GYRO_X]);
+  LOG_SENSOR(" ", "Gyro Y", this->sensors_[AS201_GYRO_Y]);
+  LOG_SENSOR(" ", "Gyro Z", this->sensors_[AS201_GYRO_Z]);
+  LOG_SENSOR(" ", "Angle X", this->sensors_[AS201_ANGLE_X]);
+  LOG_SENSOR(" ", "Angle Y", this->sensors_[AS201_ANGLE_Y]);
+  LOG_SENSOR(" ", "Angle Z", this->sensors_[AS201_ANGLE_Z]);
+  LOG_SENSOR(" ", "Field Strength X", this->sensors_[AS201_FIELD_STRENGTH_X]);
+  LOG_SENSOR(" ", "Field Strength Y", this->sensors_[AS201_FIELD_STRENGTH_Y]);
+  LOG_SENSOR(" ", "Field Strength Z", this->sensors_[AS201_FIELD_STRENGTH_Z]);
+  LOG_SENSOR(" ", "Q0", this->sensors_[AS201_Q0]);
+  LOG_SENSOR(" ", "Q1", this->sensors_[AS201_Q1]);
+  LOG_SENSOR(" ", "Q2", this->sensors_[AS201_Q2]);
+  LOG_SENSOR(" ", "Q3", this->sensors_[AS201_Q3]);
+  LOG_SENSOR(" ", "Temperature", this->sensors_[AS201_TEMPERATURE]);
+  LOG_SENSOR(" ", "Pressure", this->sensors_[AS201_PRESSURE]);
+  LOG_SENSOR(" ", "Height", this->sensors_[AS201_HEIGHT]);
+  for (uint8_t group = 0; group < AS201_GROUP_COUNT; group++) {
+    const AS201GroupFilter &filter = this->filters_[group];
+    if (filter.every > 1 || filter.deadband > 0) {
+      ESP_LOGCONFIG(TAG, "  %s: %s of %u frames, deadband %.3f", AS201_GROUP_NAMES[group],
+                    AS201_AGGREGATE_NAMES[filter.aggregate], filter.every, filter.deadband);
+    }
+  }
+  if (this->export_batch_size_ > 0) {
+    ESP_LOGCONFIG(TAG, "  Export: %u samples per batch", this->export_batch_size_);
+  }
+  this->vibration_.dump_config();
 }
 
 void AS201Component::loop() {
-  uint8_t peeked;
-  while (this->available()) {
-    if (!this->head_found && this->peek_byte(&peeked) && peeked != AS201_CMD_HEAD[0]) {
-      this->read();
-    } else {
-      this->head_found = true;  // fixme 重复设置head_found
-    }
-    if (this->head_found) {
-      this->receive_buffer.push_back((uint8_t) this->read());
+  // 批量读入环形缓冲区, 一次最多读到缓冲区末尾
+  size_t avail = this->available();
+  while (avail > 0 && this->ring_used_() < AS201_RING_SIZE) {
+    size_t pos = this->ring_head_ & AS201_RING_MASK;
+    size_t space = std::min(AS201_RING_SIZE - this->ring_used_(), AS201_RING_SIZE - pos);
+    size_t n = std::min(avail, space);
+    if (!this->read_array(this->ring_ + pos, n)) {
+      break;
     }
+    this->ring_head_ += n;
+    avail -= n;
   }
-  if (this->receive_buffer.size() < 5) {  // head + len + tail
-    return;                               // Not enough data to process
-  }
-  uint8_t data_size = this->receive_buffer[2];
-  if (this->receive_buffer.size() < (5 + data_size)) {  // head + len + tail
-    return;                                             // Not enough data to process
-  }
-  if (memcpy(this->receive_buffer.data(), AS201_CMD_HEAD, 2) != 0) {
-    this->head_found = false;
-    this->receive_buffer.clear();
-    return;
-  }
-  if (memcpy(this->receive_buffer.data() + data_size + 3, AS201_CMD_TAIL, 2) != 0) {
-    this->head_found = false;
-    this->receive_buffer.clear();
-    return;
-  }
-  uint8_t cmd = this->receive_buffer[3];
-  uint8_t checksum = this->receive_buffer[data_size + 2];
-  uint8_t calculated_checksum = 0;
-  for (uint8_t i = 0; i < data_size-1; i++) {
-    calculated_checksum += this->receive_buffer[3 + i];
-  }
-  if (calculated_checksum != checksum) {
-    ESP_LOGW(TAG, "Checksum error: expected 0x%02X, got 0x%02X", checksum, calculated_checksum);
-    this->head_found = false;
-    this->receive_buffer.clear();
-    return;
+
+  // FA FB len cmd data... checksum FC FD, len = cmd + data + checksum
+  while (this->ring_used_() >= 5) {
+    if (this->ring_at_(0) != AS201_CMD_HEAD[0] || this->ring_at_(1) != AS201_CMD_HEAD[1]) {
+      this->ring_tail_++;  // 丢一个字节, 在下一个可能的帧头重新同步
+      continue;
+    }
+    uint8_t len = this->ring_at_(2);
+    if (len < 2) {
+      this->ring_tail_++;
+      continue;
+    }
+    if (this->ring_used_() < (size_t) len + 5) {
+      return;  // 帧还没收全
+    }
+    if (this->ring_at_(len + 3) != AS201_CMD_TAIL[0] || this->ring_at_(len + 4) != AS201_CMD_TAIL[1]) {
+      ESP_LOGV(TAG, "Bad frame tail, resync");
+      this->ring_tail_++;
+      continue;
+    }
+    uint8_t checksum = this->ring_at_(len + 2);
+    uint8_t calculated_checksum = 0;
+    for (uint8_t i = 0; i < len - 1; i++) {
+      calculated_checksum += this->ring_at_(3 + i);
+    }
+    if (calculated_checksum != checksum) {
+      ESP_LOGW(TAG, "Checksum error: expected 0x%02X, got 0x%02X", checksum, calculated_checksum);
+      this->ring_tail_++;
+      continue;
+    }
+    this->handle_frame_(len);
+    this->ring_tail_ += len + 5;
   }
+}
+
+void AS201Component::handle_frame_(uint8_t len) {
+  uint8_t cmd = this->ring_at_(3);
   switch (cmd) {
     case 0x00: {
-      this->parse_data();
+      this->parse_data(len);
       break;
     }
     case 0x10: {  // get version resp
+      // len = cmd + data + checksum, 版本号应答带 6 个字节数据
+      if (len < 2 + 6) {
+        ESP_LOGW(TAG, "Version response too short: len %u", len);
+        break;
+      }
 #ifdef USE_TEXT_SENSOR
-      uint8_t minor = this->receive_buffer[4];
-      uint8_t major = this->receive_buffer[5];
-      uint8_t hour = this->receive_buffer[6];
-      uint8_t day = this->receive_buffer[7];
-      uint8_t month = this->receive_buffer[8];
-      uint16_t year = (uint16_t) this->receive_buffer[9];
+      uint8_t minor = this->ring_at_(4);
+      uint8_t major = this->ring_at_(5);
+      uint8_t hour = this->ring_at_(6);
+      uint8_t day = this->ring_at_(7);
+      uint8_t month = this->ring_at_(8);
+      uint16_t year = (uint16_t) this->ring_at_(9);
       if (this->version_text_sensor_ != nullptr) {
         this->version_text_sensor_->publish_state(std::to_string(major) + "." + std::to_string(minor) + " " +
                                                   std::to_string(year) + "-" + std::to_string(month) + "-" +
@@ -120,9 +163,13 @@ void AS201Component::loop() {
       break;
     }
     case 0x14: {  // get install direction resp
+      if (len < 2 + 1) {
+        ESP_LOGW(TAG, "Install direction response too short: len %u", len);
+        break;
+      }
 #ifdef USE_SELECT
       if (this->direction_select_ != nullptr) {
-        if (this->receive_buffer[4]) {  // 垂直
+        if (this->ring_at_(4)) {  // 垂直
           this->direction_select_->publish_state("vertical");
         } else {  // 水平
           this->direction_select_->publish_state("horizontal");
@@ -149,10 +196,14 @@ void AS201Component::loop() {
       break;
     }
     case 0x19: {  // get config resp
-      uint8_t sub = this->receive_buffer[4];
-      uint8_t rate = this->receive_buffer[5];
-      uint8_t baud = this->receive_buffer[6];
-      uint8_t up = this->receive_buffer[7];
+      if (len < 2 + 4) {
+        ESP_LOGW(TAG, "Config response too short: len %u", len);
+        break;
+      }
+      uint8_t sub = this->ring_at_(4);
+      uint8_t rate = this->ring_at_(5);
+      uint8_t baud = this->ring_at_(6);
+      uint8_t up = this->ring_at_(7);
 #ifdef USE_SELECT
       if (this->upload_rate_select_ != nullptr) {
         switch (rate) {
@@ -198,11 +249,11 @@ void AS201Component::loop() {
       break;
     }
     case 0x1B: {
-      this->parse_data();
+      this->parse_data(len);
       break;
     }
     case 0x1C: {  // error resp
-      if (this->receive_buffer[4]) {
+      if (this->ring_at_(4)) {
         ESP_LOGI(TAG, "calibrate done");
       } else {
         ESP_LOGW(TAG, "calibrate failed");
@@ -218,11 +269,54 @@ void AS201Component::loop() {
       break;
     }
   }
-  this->receive_buffer.erase(this->receive_buffer.begin(), this->receive_buffer.begin() + data_size + 5);
 }
 
-void AS201Component::parse_data() {
-  uint8_t sensor_type = this->receive_buffer[4];
+void AS201Component::parse_data(uint8_t len) {
+  if (len < AS201_DATA_FRAME_LEN) {
+    ESP_LOGW(TAG, "Data frame too short: len %u", len);
+    return;
+  }
+  this->decode_sample_(this->sample_);
+  this->publish_type_(this->sample_.sensor_type);
+  this->process_sample_(this->sample_);
+  if (this->export_batch_size_ > 0) {
+    this->export_sample_();
+  }
+  if (this->vibration_.is_enabled()) {
+    const float *accel = &this->sample_.values[AS201_ACCEL_X];
+    float value;
+    if (this->vibration_.get_axis() == AS201_VIBRATION_AXIS_MAGNITUDE) {
+      value = sqrtf(accel[0] * accel[0] + accel[1] * accel[1] + accel[2] * accel[2]);
+    } else {
+      value = accel[this->vibration_.get_axis()];
+    }
+    this->vibration_.add_sample(value, millis());
+  }
+}
+
+void AS201Component::decode_sample_(AS201Sample &sample) {
+  sample.sensor_type = this->ring_at_(4);
+  // 加速度, 角速度, 磁场, 四元数都是有符号数, 欧拉角是 0~360 度
+  for (uint8_t i = 0; i < 3; i++) {
+    sample.values[AS201_ACCEL_X + i] = (float) (int16_t) this->ring_u16_(5 + i * 2) * 0.00478515625f;
+    sample.values[AS201_GYRO_X + i] = (float) (int16_t) this->ring_u16_(11 + i * 2) * 0.0625f;
+    sample.values[AS201_ANGLE_X + i] = (float) this->ring_u16_(17 + i * 2) * 0.0054931640625f;
+    sample.values[AS201_FIELD_STRENGTH_X + i] = (float) (int16_t) this->ring_u16_(23 + i * 2) * 0.006103515625f;
+  }
+  for (uint8_t i = 0; i < 4; i++) {
+    sample.values[AS201_Q0 + i] = (float) (int16_t) this->ring_u16_(29 + i * 2) * 0.000030517578125f;
+  }
+  sample.values[AS201_TEMPERATURE] = (float) (int16_t) this->ring_u16_(37) * 0.01f;
+  sample.values[AS201_PRESSURE] = (float) (int32_t) this->ring_u32_(39) * 0.0002384185791f;
+  sample.values[AS201_HEIGHT] = (float) (int32_t) this->ring_u32_(43) * 0.0010728836f;
+}
+
+void AS201Component::publish_type_(uint8_t sensor_type) {
+  // 类型和精度很少变化, 只在变化时发布
+  if (sensor_type == this->last_sensor_type_) {
+    return;
+  }
+  this->last_sensor_type_ = sensor_type;
   std::bitset<8> sensor_type_bits(sensor_type);
 #ifdef USE_TEXT_SENSOR
   if (this->type_text_sensor_ != nullptr) {
@@ -248,88 +342,120 @@ void AS201Component::parse_data() {
     }
   }
 #endif
+}
+
+void AS201Component::process_sample_(const AS201Sample &sample) {
 #ifdef USE_SENSOR
-  if (this->accel_x_sensor_ != nullptr) {
-    uint16_t accel_x = (uint16_t) this->receive_buffer[5] | ((uint16_t) this->receive_buffer[6]) << 8;
-    this->accel_x_sensor_->publish_state((float) accel_x * 0.00478515625);
-  }
-  if (this->accel_y_sensor_ != nullptr) {
-    uint16_t accel_y = (uint16_t) this->receive_buffer[7] | ((uint16_t) this->receive_buffer[8]) << 8;
-    this->accel_y_sensor_->publish_state((float) accel_y * 0.00478515625);
-  }
-  if (this->accel_z_sensor_ != nullptr) {
-    uint16_t accel_z = (uint16_t) this->receive_buffer[9] | ((uint16_t) this->receive_buffer[10]) << 8;
-    this->accel_z_sensor_->publish_state((float) accel_z * 0.00478515625);
-  }
-  if (this->gyro_x_sensor_ != nullptr) {
-    uint16_t gyro_x = (uint16_t) this->receive_buffer[11] | ((uint16_t) this->receive_buffer[12]) << 8;
-    this->gyro_x_sensor_->publish_state((float) gyro_x * 0.0625);
-  }
-  if (this->gyro_y_sensor_ != nullptr) {
-    uint16_t gyro_y = (uint16_t) this->receive_buffer[13] | ((uint16_t) this->receive_buffer[14]) << 8;
-    this->gyro_y_sensor_->publish_state((float) gyro_y * 0.0625);
-  }
-  if (this->gyro_z_sensor_ != nullptr) {
-    uint16_t gyro_z = (uint16_t) this->receive_buffer[15] | ((uint16_t) this->receive_buffer[16]) << 8;
-    this->gyro_z_sensor_->publish_state((float) gyro_z * 0.0625);
-  }
-  if (this->angle_x_sensor_ != nullptr) {
-    uint16_t angle_x = (uint16_t) this->receive_buffer[17] | ((uint16_t) this->receive_buffer[18]) << 8;
-    this->angle_x_sensor_->publish_state((float) angle_x * 0.0054931640625);
-  }
-  if (this->angle_y_sensor_ != nullptr) {
-    uint16_t angle_y = (uint16_t) this->receive_buffer[19] | ((uint16_t) this->receive_buffer[20]) << 8;
-    this->angle_y_sensor_->publish_state((float) angle_y * 0.0054931640625);
-  }
-  if (this->angle_z_sensor_ != nullptr) {
-    uint16_t angle_z = (uint16_t) this->receive_buffer[21] | ((uint16_t) this->receive_buffer[22]) << 8;
-    this->angle_z_sensor_->publish_state((float) angle_z * 0.0054931640625);
-  }
-  if (this->field_strength_x_sensor_ != nullptr) {
-    uint16_t field_strength_x = (uint16_t) this->receive_buffer[23] | ((uint16_t) this->receive_buffer[24]) << 8;
-    this->field_strength_x_sensor_->publish_state((float) field_strength_x * 0.006103515625);
-  }
-  if (this->field_strength_y_sensor_ != nullptr) {
-    uint16_t field_strength_y = (uint16_t) this->receive_buffer[25] | ((uint16_t) this->receive_buffer[26]) << 8;
-    this->field_strength_y_sensor_->publish_state((float) field_strength_y * 0.006103515625);
-  }
-  if (this->field_strength_z_sensor_ != nullptr) {
-    uint16_t field_strength_z = (uint16_t) this->receive_buffer[27] | ((uint16_t) this->receive_buffer[28]) << 8;
-    this->field_strength_z_sensor_->publish_state((float) field_strength_z * 0.006103515625);
+  for (uint8_t group = 0; group < AS201_GROUP_COUNT; group++) {
+    uint8_t first = AS201_GROUP_FIRST[group];
+    uint8_t last = AS201_GROUP_FIRST[group + 1];
+    bool used = false;
+    for (uint8_t c = first; c < last; c++) {
+      used |= this->sensors_[c] != nullptr;
+    }
+    if (!used) {
+      continue;
+    }
+    AS201GroupFilter &filter = this->filters_[group];
+    // 欧拉角是 0~360 度, 不能直接算术平均(359 和 1 会平均成 180), 按单位向量求平均
+    bool circular = group == AS201_GROUP_ANGLE && filter.aggregate == AS201_AGGREGATE_MEAN;
+    for (uint8_t c = first; c < last; c++) {
+      float value = sample.values[c];
+      if (circular) {
+        float rad = value * (float) M_PI / 180.0f;
+        float &cos_sum = this->angle_cos_[c - AS201_ANGLE_X];
+        this->aggregated_[c] = filter.count == 0 ? sinf(rad) : this->aggregated_[c] + sinf(rad);
+        cos_sum = filter.count == 0 ? cosf(rad) : cos_sum + cosf(rad);
+        continue;
+      }
+      if (filter.count == 0) {
+        this->aggregated_[c] = value;
+        continue;
+      }
+      switch (filter.aggregate) {
+        case AS201_AGGREGATE_MEAN:
+          this->aggregated_[c] += value;
+          break;
+        case AS201_AGGREGATE_MIN:
+          this->aggregated_[c] = std::min(this->aggregated_[c], value);
+          break;
+        case AS201_AGGREGATE_MAX:
+          this->aggregated_[c] = std::max(this->aggregated_[c], value);
+          break;
+        case AS201_AGGREGATE_LAST:
+          this->aggregated_[c] = value;
+          break;
+      }
+    }
+    if (++filter.count < filter.every) {
+      continue;
+    }
+    for (uint8_t c = first; c < last; c++) {
+      float value = this->aggregated_[c];
+      if (circular) {
+        value = atan2f(value, this->angle_cos_[c - AS201_ANGLE_X]) * 180.0f / (float) M_PI;
+        if (value < 0) {
+          value += 360.0f;
+        }
+      } else if (filter.aggregate == AS201_AGGREGATE_MEAN) {
+        value /= filter.count;
+      }
+      this->publish_channel_(c, value, filter.deadband);
+    }
+    filter.count = 0;
   }
+#endif
+}
 
-  if (this->q0_sensor_ != nullptr) {
-    uint16_t q0 = (uint16_t) this->receive_buffer[29] | ((uint16_t) this->receive_buffer[30]) << 8;
-    this->q0_sensor_->publish_state((float) q0 * 0.000030517578125);
-  }
-  if (this->q1_sensor_ != nullptr) {
-    uint16_t q1 = (uint16_t) this->receive_buffer[31] | ((uint16_t) this->receive_buffer[32]) << 8;
-    this->q1_sensor_->publish_state((float) q1 * 0.000030517578125);
-  }
-  if (this->q2_sensor_ != nullptr) {
-    uint16_t q2 = (uint16_t) this->receive_buffer[33] | ((uint16_t) this->receive_buffer[34]) << 8;
-    this->q2_sensor_->publish_state((float) q2 * 0.000030517578125);
+void AS201Component::publish_channel_(uint8_t channel, float value, float deadband) {
+#ifdef USE_SENSOR
+  sensor::Sensor *sens = this->sensors_[channel];
+  if (sens == nullptr) {
+    return;
   }
-  if (this->q3_sensor_ != nullptr) {
-    uint16_t q3 = (uint16_t) this->receive_buffer[35] | ((uint16_t) this->receive_buffer[36]) << 8;
-    this->q3_sensor_->publish_state((float) q3 * 0.000030517578125);
+  float &published = this->published_[channel];
+  if (!std::isnan(published) && std::fabs(value - published) < deadband) {
+    return;
   }
+  published = value;
+  sens->publish_state(value);
+#endif
+}
 
-  if (this->temperature_sensor_ != nullptr) {
-    int16_t temperature = (int16_t) this->receive_buffer[37] | ((int16_t) this->receive_buffer[38]) << 8;
-    this->temperature_sensor_->publish_state((float) temperature * 0.01);
-  }
-  if (this->pressure_sensor_ != nullptr) {
-    int32_t pressure = (int32_t) this->receive_buffer[39] | ((int32_t) this->receive_buffer[40]) << 8 |
-                       ((int32_t) this->receive_buffer[41]) << 16 | ((int32_t) this->receive_buffer[42]) << 24;
-    this->pressure_sensor_->publish_state((float) pressure * 0.0002384185791);
+void AS201Component::export_sample_() {
+  uint32_t now = millis();
+  uint8_t *header = this->export_buffer_.data();
+  if (this->export_count_ == 0) {
+    header[0] = 'A';
+    header[1] = 'S';
+    header[2] = AS201_EXPORT_VERSION;
+    header[4] = this->frame_counter_ & 0xFF;
+    header[5] = (this->frame_counter_ >> 8) & 0xFF;
+    header[6] = now & 0xFF;
+    header[7] = (now >> 8) & 0xFF;
+    header[8] = (now >> 16) & 0xFF;
+    header[9] = (now >> 24) & 0xFF;
+    this->export_last_time_ = now;
+  }
+  uint16_t dt = std::min<uint32_t>(now - this->export_last_time_, 0xFFFF);
+  this->export_last_time_ = now;
+  uint8_t *p = header + AS201_EXPORT_HEADER_SIZE + this->export_count_ * AS201_EXPORT_SAMPLE_SIZE;
+  p[0] = dt & 0xFF;
+  p[1] = (dt >> 8) & 0xFF;
+  for (uint8_t i = 0; i < AS201_EXPORT_SAMPLE_SIZE - 2; i++) {
+    p[2 + i] = this->ring_at_(5 + i);
+  }
+  this->frame_counter_++;
+  if (++this->export_count_ < this->export_batch_size_) {
+    return;
   }
-  if (this->height_sensor_ != nullptr) {
-    int32_t height = (int32_t) this->receive_buffer[43] | ((int32_t) this->receive_buffer[44]) << 8 |
-                     ((int32_t) this->receive_buffer[45]) << 16 | ((int32_t) this->receive_buffer[46]) << 24;
-    this->height_sensor_->publish_state((float) height * 0.0010728836);
+  header[3] = this->export_count_;
+  size_t len = AS201_EXPORT_HEADER_SIZE + this->export_count_ * AS201_EXPORT_SAMPLE_SIZE;
+  this->export_count_ = 0;
+  if (this->export_uart_ != nullptr) {
+    this->export_uart_->write_array(header, len);
   }
-#endif
+  this->batch_callback_.call(std::vector<uint8_t>(header, header + len));
 }
 
 void AS201Component::send_command(uint8_t command, const uint8_t *data, uint16_t data_size) {
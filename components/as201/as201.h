@@ -1,12 +1,13 @@
 #pragma once
 
 #include <array>
+#include <cmath>
 #include <vector>
-#include <queue>
 #include "esphome/core/defines.h"
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
 #include "esphome/components/uart/uart.h"
+#include "vibration.h"
 #ifdef USE_SENSOR
 #include "esphome/components/sensor/sensor.h"
 #endif
@@ -26,6 +27,75 @@
 namespace esphome {
 namespace as201 {
 
+// 最长一帧 255 + 5 字节, 环形缓冲区至少要放得下一帧
+static const size_t AS201_RING_SIZE = 512;
+static const size_t AS201_RING_MASK = AS201_RING_SIZE - 1;
+
+enum AS201Channel : uint8_t {
+  AS201_ACCEL_X,
+  AS201_ACCEL_Y,
+  AS201_ACCEL_Z,
+  AS201_GYRO_X,
+  AS201_GYRO_Y,
+  AS201_GYRO_Z,
+  AS201_ANGLE_X,
+  AS201_ANGLE_Y,
+  AS201_ANGLE_Z,
+  AS201_FIELD_STRENGTH_X,
+  AS201_FIELD_STRENGTH_Y,
+  AS201_FIELD_STRENGTH_Z,
+  AS201_Q0,
+  AS201_Q1,
+  AS201_Q2,
+  AS201_Q3,
+  AS201_TEMPERATURE,
+  AS201_PRESSURE,
+  AS201_HEIGHT,
+  AS201_CHANNEL_COUNT,
+};
+
+// 与 set_subscribe_flag 的分组一致
+enum AS201Group : uint8_t {
+  AS201_GROUP_ACCEL,
+  AS201_GROUP_GYRO,
+  AS201_GROUP_ANGLE,
+  AS201_GROUP_FIELD_STRENGTH,
+  AS201_GROUP_QUATERNION,
+  AS201_GROUP_TEMPERATURE,
+  AS201_GROUP_PRESSURE,
+  AS201_GROUP_HEIGHT,
+  AS201_GROUP_COUNT,
+};
+
+enum AS201Aggregate : uint8_t {
+  AS201_AGGREGATE_MEAN,
+  AS201_AGGREGATE_MIN,
+  AS201_AGGREGATE_MAX,
+  AS201_AGGREGATE_LAST,
+};
+
+// 一帧数据解码后的结果, values 按 AS201Channel 排列
+struct AS201Sample {
+  uint8_t sensor_type;
+  float values[AS201_CHANNEL_COUNT];
+};
+
+// 二进制批量导出, 小端:
+// 头: 'A' 'S' version count counter(u16) timestamp(u32 ms)
+// 每个采样: dt(u16 ms, 相对上一个采样) + 数据帧第 5~46 字节原样拷贝(int16 x 17, int32 x 2)
+static const uint8_t AS201_EXPORT_VERSION = 1;
+static const size_t AS201_EXPORT_HEADER_SIZE = 10;
+static const size_t AS201_EXPORT_SAMPLE_SIZE = 44;
+static const size_t AS201_EXPORT_MAX_BATCH = 32;  // 一批不超过一个 udp 数据报
+
+// 每 every 帧聚合一次再发布, 与上次发布值相差小于 deadband 则不发布
+struct AS201GroupFilter {
+  uint8_t every{1};
+  AS201Aggregate aggregate{AS201_AGGREGATE_MEAN};
+  float deadband{0.0f};
+  uint8_t count{0};
+};
+
 class AS201Component : public Component, public uart::UARTDevice {
 #ifdef USE_TEXT_SENSOR
   SUB_TEXT_SENSOR(version)
@@ -73,50 +143,72 @@ class AS201Component : public Component, public uart::UARTDevice {
                                           bool field_strength, bool quaternion,
                                           bool temperature, bool pressure, bool height);
 
-  void parse_data();
-
-  void set_accel_x_sensor(sensor::Sensor *accel_x_sensor) { this->accel_x_sensor_ = accel_x_sensor; }
-  void set_accel_y_sensor(sensor::Sensor *accel_y_sensor) { this->accel_y_sensor_ = accel_y_sensor; }
-  void set_accel_z_sensor(sensor::Sensor *accel_z_sensor) { this->accel_z_sensor_ = accel_z_sensor; }
-  void set_gyro_x_sensor(sensor::Sensor *gyro_x_sensor) { this->gyro_x_sensor_ = gyro_x_sensor; }
-  void set_gyro_y_sensor(sensor::Sensor *gyro_y_sensor) { this->gyro_y_sensor_ = gyro_y_sensor; }
-  void set_gyro_z_sensor(sensor::Sensor *gyro_z_sensor) { this->gyro_z_sensor_ = gyro_z_sensor; }
-  void set_angle_x_sensor(sensor::Sensor *angle_x_sensor) { this->angle_x_sensor_ = angle_x_sensor; }
-  void set_angle_y_sensor(sensor::Sensor *angle_y_sensor) { this->angle_y_sensor_ = angle_y_sensor; }
-  void set_angle_z_sensor(sensor::Sensor *angle_z_sensor) { this->angle_z_sensor_ = angle_z_sensor; }
-  void set_field_strength_x_sensor(sensor::Sensor *field_strength_x_sensor) { this->field_strength_x_sensor_ = field_strength_x_sensor; }
-  void set_field_strength_y_sensor(sensor::Sensor *field_strength_y_sensor) { this->field_strength_y_sensor_ = field_strength_y_sensor; }
-  void set_field_strength_z_sensor(sensor::Sensor *field_strength_z_sensor) { this->field_strength_z_sensor_ = field_strength_z_sensor; }
-  void set_q0_sensor(sensor::Sensor *q0_sensor) { this->q0_sensor_ = q0_sensor; }
-  void set_q1_sensor(sensor::Sensor *q1_sensor) { this->q1_sensor_ = q1_sensor; }
-  void set_q2_sensor(sensor::Sensor *q2_sensor) { this->q2_sensor_ = q2_sensor; }
-  void set_q3_sensor(sensor::Sensor *q3_sensor) { this->q3_sensor_ = q3_sensor; }
-  void set_temperature_sensor(sensor::Sensor *temperature_sensor) { this->temperature_sensor_ = temperature_sensor; }
-  void set_pressure_sensor(sensor::Sensor *pressure_sensor) { this->pressure_sensor_ = pressure_sensor; }
-  void set_height_sensor(sensor::Sensor *height_sensor) { this->height_sensor_ = height_sensor; }
+  void parse_data(uint8_t len);
+
+  void set_accel_x_sensor(sensor::Sensor *accel_x_sensor) { this->sensors_[AS201_ACCEL_X] = accel_x_sensor; }
+  void set_accel_y_sensor(sensor::Sensor *accel_y_sensor) { this->sensors_[AS201_ACCEL_Y] = accel_y_sensor; }
+  void set_accel_z_sensor(sensor::Sensor *accel_z_sensor) { this->sensors_[AS201_ACCEL_Z] = accel_z_sensor; }
+  void set_gyro_x_sensor(sensor::Sensor *gyro_x_sensor) { this->sensors_[AS201_GYRO_X] = gyro_x_sensor; }
+  void set_gyro_y_sensor(sensor::Sensor *gyro_y_sensor) { this->sensors_[AS201_GYRO_Y] = gyro_y_sensor; }
+  void set_gyro_z_sensor(sensor::Sensor *gyro_z_sensor) { this->sensors_[AS201_GYRO_Z] = gyro_z_sensor; }
+  void set_angle_x_sensor(sensor::Sensor *angle_x_sensor) { this->sensors_[AS201_ANGLE_X] = angle_x_sensor; }
+  void set_angle_y_sensor(sensor::Sensor *angle_y_sensor) { this->sensors_[AS201_ANGLE_Y] = angle_y_sensor; }
+  void set_angle_z_sensor(sensor::Sensor *angle_z_sensor) { this->sensors_[AS201_ANGLE_Z] = angle_z_sensor; }
+  void set_field_strength_x_sensor(sensor::Sensor *field_strength_x_sensor) { this->sensors_[AS201_FIELD_STRENGTH_X] = field_strength_x_sensor; }
+  void set_field_strength_y_sensor(sensor::Sensor *field_strength_y_sensor) { this->sensors_[AS201_FIELD_STRENGTH_Y] = field_strength_y_sensor; }
+  void set_field_strength_z_sensor(sensor::Sensor *field_strength_z_sensor) { this->sensors_[AS201_FIELD_STRENGTH_Z] = field_strength_z_sensor; }
+  void set_q0_sensor(sensor::Sensor *q0_sensor) { this->sensors_[AS201_Q0] = q0_sensor; }
+  void set_q1_sensor(sensor::Sensor *q1_sensor) { this->sensors_[AS201_Q1] = q1_sensor; }
+  void set_q2_sensor(sensor::Sensor *q2_sensor) { this->sensors_[AS201_Q2] = q2_sensor; }
+  void set_q3_sensor(sensor::Sensor *q3_sensor) { this->sensors_[AS201_Q3] = q3_sensor; }
+  void set_temperature_sensor(sensor::Sensor *temperature_sensor) { this->sensors_[AS201_TEMPERATURE] = temperature_sensor; }
+  void set_pressure_sensor(sensor::Sensor *pressure_sensor) { this->sensors_[AS201_PRESSURE] = pressure_sensor; }
+  void set_height_sensor(sensor::Sensor *height_sensor) { this->sensors_[AS201_HEIGHT] = height_sensor; }
+  VibrationAnalyzer &get_vibration() { return this->vibration_; }
+  void set_export_batch_size(uint8_t size) { this->export_batch_size_ = size; }
+  void set_export_uart(uart::UARTComponent *export_uart) { this->export_uart_ = export_uart; }
+  void add_on_batch_callback(std::function<void(const std::vector<uint8_t> &)> &&callback) {
+    this->batch_callback_.add(std::move(callback));
+  }
+  void set_group_filter(AS201Group group, uint8_t every, AS201Aggregate aggregate, float deadband) {
+    this->filters_[group].every = every;
+    this->filters_[group].aggregate = aggregate;
+    this->filters_[group].deadband = deadband;
+  }
  protected:
-  std::vector<uint8_t> receive_buffer;
-  bool head_found{false};
-
-  sensor::Sensor * accel_x_sensor_{nullptr};
-  sensor::Sensor * accel_y_sensor_{nullptr};
-  sensor::Sensor * accel_z_sensor_{nullptr};
-  sensor::Sensor * gyro_x_sensor_{nullptr};
-  sensor::Sensor * gyro_y_sensor_{nullptr};
-  sensor::Sensor * gyro_z_sensor_{nullptr};
-  sensor::Sensor * angle_x_sensor_{nullptr};
-  sensor::Sensor * angle_y_sensor_{nullptr};
-  sensor::Sensor * angle_z_sensor_{nullptr};
-  sensor::Sensor * field_strength_x_sensor_{nullptr};
-  sensor::Sensor * field_strength_y_sensor_{nullptr};
-  sensor::Sensor * field_strength_z_sensor_{nullptr};
-  sensor::Sensor * q0_sensor_{nullptr};
-  sensor::Sensor * q1_sensor_{nullptr};
-  sensor::Sensor * q2_sensor_{nullptr};
-  sensor::Sensor * q3_sensor_{nullptr};
-  sensor::Sensor * temperature_sensor_{nullptr};
-  sensor::Sensor * pressure_sensor_{nullptr};
-  sensor::Sensor * height_sensor_{nullptr};
+  // 读写位置只增不减, 取下标时再与 mask 相与, 16 位回绕正好是 AS201_RING_SIZE 的整数倍
+  uint8_t ring_[AS201_RING_SIZE];
+  uint16_t ring_head_{0};
+  uint16_t ring_tail_{0};
+  size_t ring_used_() const { return (uint16_t) (this->ring_head_ - this->ring_tail_); }
+  uint8_t ring_at_(size_t offset) const { return this->ring_[(this->ring_tail_ + offset) & AS201_RING_MASK]; }
+  uint16_t ring_u16_(size_t offset) const { return this->ring_at_(offset) | ((uint16_t) this->ring_at_(offset + 1)) << 8; }
+  uint32_t ring_u32_(size_t offset) const {
+    return this->ring_u16_(offset) | ((uint32_t) this->ring_u16_(offset + 2)) << 16;
+  }
+  void handle_frame_(uint8_t len);
+  void decode_sample_(AS201Sample &sample);
+  void publish_type_(uint8_t sensor_type);
+  void process_sample_(const AS201Sample &sample);
+  void publish_channel_(uint8_t channel, float value, float deadband);
+  void export_sample_();
+
+  std::array<sensor::Sensor *, AS201_CHANNEL_COUNT> sensors_{};
+  std::array<AS201GroupFilter, AS201_GROUP_COUNT> filters_{};
+  std::array<float, AS201_CHANNEL_COUNT> aggregated_{};  // 角度取平均时存 sin 的和
+  std::array<float, 3> angle_cos_{};                     // 角度取平均时 cos 的和
+  std::array<float, AS201_CHANNEL_COUNT> published_{};  // NAN 表示还没发布过
+  AS201Sample sample_{};
+  VibrationAnalyzer vibration_;
+
+  uint8_t export_batch_size_{0};
+  uart::UARTComponent *export_uart_{nullptr};
+  LazyCallbackManager<void(const std::vector<uint8_t> &)> batch_callback_;
+  std::vector<uint8_t> export_buffer_;  // 开启导出时在 setup() 里按批大小分配
+  uint8_t export_count_{0};
+  uint16_t frame_counter_{0};
+  uint32_t export_last_time_{0};
+  uint16_t last_sensor_type_{0xFFFF};
 
   void send_command(uint8_t command, const uint8_t *data, uint16_t data_size);
 
@@ -183,5 +275,12 @@ template<typename... Ts> class SetSubscribeFlagAction : public Action<Ts...> {
 };
 
 
+class AS201BatchTrigger : public Trigger<std::vector<uint8_t>> {
+ public:
+  explicit AS201BatchTrigger(AS201Component *parent) {
+    parent->add_on_batch_callback([this](const std::vector<uint8_t> &data) { this->trigger(data); });
+  }
+};
+
 } // namespace as201
 } // namespace esphome
\ No newline at end of file
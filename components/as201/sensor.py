@@ -6,9 +6,10 @@ from esphome.const import (
     UNIT_PASCAL, DEVICE_CLASS_ATMOSPHERIC_PRESSURE, CONF_HEIGHT, UNIT_METER,
     STATE_CLASS_MEASUREMENT, UNIT_METER_PER_SECOND_SQUARED, ICON_BRIEFCASE_DOWNLOAD,
     UNIT_DEGREE_PER_SECOND, ICON_SCREEN_ROTATION, UNIT_DEGREES, CONF_FIELD_STRENGTH_X, CONF_FIELD_STRENGTH_Y,
-    CONF_FIELD_STRENGTH_Z, UNIT_MICROTESLA, ICON_MAGNET,
+    CONF_FIELD_STRENGTH_Z, UNIT_MICROTESLA, ICON_MAGNET, UNIT_HERTZ,
+    CONF_FROM, CONF_TO,
 )
-from . import CONF_AS201_ID, AS201Component
+from . import CONF_AS201_ID, AS201Component, as201
 
 DEPENDENCIES = ["as201"]
 
@@ -25,11 +26,119 @@ CONF_Q0 = "q0"
 CONF_Q1 = "q1"
 CONF_Q2 = "q2"
 CONF_Q3 = "q3"
+CONF_PUBLISH = "publish"
+CONF_EVERY = "every"
+CONF_AGGREGATE = "aggregate"
+CONF_DEADBAND = "deadband"
+CONF_VIBRATION = "vibration"
+CONF_AXIS = "axis"
+CONF_WINDOW_SIZE = "window_size"
+CONF_RMS = "rms"
+CONF_PEAK_FREQUENCY = "peak_frequency"
+CONF_BANDS = "bands"
+CONF_ENERGY = "energy"
+
+AS201Group = as201.enum("AS201Group")
+AS201_GROUPS = {
+    "accel": AS201Group.AS201_GROUP_ACCEL,
+    "gyro": AS201Group.AS201_GROUP_GYRO,
+    "angle": AS201Group.AS201_GROUP_ANGLE,
+    "field_strength": AS201Group.AS201_GROUP_FIELD_STRENGTH,
+    "quaternion": AS201Group.AS201_GROUP_QUATERNION,
+    "temperature": AS201Group.AS201_GROUP_TEMPERATURE,
+    "pressure": AS201Group.AS201_GROUP_PRESSURE,
+    "height": AS201Group.AS201_GROUP_HEIGHT,
+}
+
+AS201Aggregate = as201.enum("AS201Aggregate")
+AS201_AGGREGATES = {
+    "mean": AS201Aggregate.AS201_AGGREGATE_MEAN,
+    "min": AS201Aggregate.AS201_AGGREGATE_MIN,
+    "max": AS201Aggregate.AS201_AGGREGATE_MAX,
+    "last": AS201Aggregate.AS201_AGGREGATE_LAST,
+}
+
+AS201VibrationAxis = as201.enum("AS201VibrationAxis")
+AS201_VIBRATION_AXES = {
+    "x": AS201VibrationAxis.AS201_VIBRATION_AXIS_X,
+    "y": AS201VibrationAxis.AS201_VIBRATION_AXIS_Y,
+    "z": AS201VibrationAxis.AS201_VIBRATION_AXIS_Z,
+    "magnitude": AS201VibrationAxis.AS201_VIBRATION_AXIS_MAGNITUDE,
+}
+AS201_FFT_MAX_SIZE = 256
+
+
+def validate_window_size(value):
+    value = cv.int_range(min=8, max=AS201_FFT_MAX_SIZE)(value)
+    if value & (value - 1) != 0:
+        raise cv.Invalid("window_size must be a power of two")
+    return value
+
+
+def validate_vibration(config):
+    if CONF_EVERY in config and config[CONF_EVERY] > config[CONF_WINDOW_SIZE]:
+        raise cv.Invalid("every must not be larger than window_size")
+    for band in config[CONF_BANDS]:
+        if band[CONF_FROM] >= band[CONF_TO]:
+            raise cv.Invalid("band 'from' must be lower than 'to'")
+    return config
+
+
+# 对加速度做 FFT, 频率上限是上传频率的一半
+VIBRATION_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.Optional(CONF_AXIS, default="z"): cv.enum(AS201_VIBRATION_AXES, lower=True),
+            cv.Optional(CONF_WINDOW_SIZE, default=128): validate_window_size,
+            cv.Optional(CONF_EVERY): cv.int_range(min=1, max=AS201_FFT_MAX_SIZE),
+            cv.Optional(CONF_RMS): sensor.sensor_schema(
+                unit_of_measurement=UNIT_METER_PER_SECOND_SQUARED,
+                icon="mdi:vibrate",
+                accuracy_decimals=3,
+                state_class=STATE_CLASS_MEASUREMENT,
+            ),
+            cv.Optional(CONF_PEAK_FREQUENCY): sensor.sensor_schema(
+                unit_of_measurement=UNIT_HERTZ,
+                icon="mdi:sine-wave",
+                accuracy_decimals=2,
+                state_class=STATE_CLASS_MEASUREMENT,
+            ),
+            cv.Optional(CONF_BANDS, default=[]): cv.ensure_list(
+                cv.Schema(
+                    {
+                        cv.Required(CONF_FROM): cv.positive_float,
+                        cv.Required(CONF_TO): cv.positive_float,
+                        cv.Required(CONF_ENERGY): sensor.sensor_schema(
+                            icon="mdi:vibrate",
+                            accuracy_decimals=4,
+                            state_class=STATE_CLASS_MEASUREMENT,
+                        ),
+                    }
+                )
+            ),
+        }
+    ),
+    validate_vibration,
+)
+
+# 每组每 every 帧聚合一次, 与上次发布值相差小于 deadband 时不发布
+# 欧拉角组的 mean 是圆周平均, 跨过 0/360 度也正确
+GROUP_FILTER_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_EVERY, default=1): cv.int_range(min=1, max=255),
+        cv.Optional(CONF_AGGREGATE, default="mean"): cv.enum(AS201_AGGREGATES, lower=True),
+        cv.Optional(CONF_DEADBAND, default=0.0): cv.positive_float,
+    }
+)
 
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
             cv.GenerateID(CONF_AS201_ID): cv.use_id(AS201Component),
+            cv.Optional(CONF_VIBRATION): VIBRATION_SCHEMA,
+            cv.Optional(CONF_PUBLISH, default={}): cv.Schema(
+                {cv.Optional(group): GROUP_FILTER_SCHEMA for group in AS201_GROUPS}
+            ),
             cv.Optional(CONF_ACCEL_X): sensor.sensor_schema(
                 unit_of_measurement=UNIT_METER_PER_SECOND_SQUARED,
                 icon=ICON_BRIEFCASE_DOWNLOAD,
@@ -217,3 +326,26 @@ async def to_code(config):
     if CONF_HEIGHT in config:
         sens = await sensor.new_sensor(config[CONF_HEIGHT])
         cg.add(as201_component.set_height_sensor(sens))
+
+    for group, filter_config in config[CONF_PUBLISH].items():
+        cg.add(as201_component.set_group_filter(
+            AS201_GROUPS[group],
+            filter_config[CONF_EVERY],
+            filter_config[CONF_AGGREGATE],
+            filter_config[CONF_DEADBAND],
+        ))
+
+    if vibration_config := config.get(CONF_VIBRATION):
+        vibration = as201_component.get_vibration()
+        cg.add(vibration.set_axis(vibration_config[CONF_AXIS]))
+        cg.add(vibration.set_window_size(vibration_config[CONF_WINDOW_SIZE]))
+        cg.add(vibration.set_every(vibration_config.get(CONF_EVERY, vibration_config[CONF_WINDOW_SIZE])))
+        if CONF_RMS in vibration_config:
+            sens = await sensor.new_sensor(vibration_config[CONF_RMS])
+            cg.add(vibration.set_rms_sensor(sens))
+        if CONF_PEAK_FREQUENCY in vibration_config:
+            sens = await sensor.new_sensor(vibration_config[CONF_PEAK_FREQUENCY])
+            cg.add(vibration.set_peak_frequency_sensor(sens))
+        for band in vibration_config[CONF_BANDS]:
+            sens = await sensor.new_sensor(band[CONF_ENERGY])
+            cg.add(vibration.add_band(band[CONF_FROM], band[CONF_TO], sens))
@@ -0,0 +1,162 @@
+#include "vibration.h"
+#include <cmath>
+#include <utility>
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace as201 {
+
+static const char *const TAG = "as201.vibration";
+
+static const char *const AXIS_NAMES[] = {"x", "y", "z", "magnitude"};
+
+void VibrationAnalyzer::setup() {
+  if (!this->is_enabled()) {
+    return;
+  }
+  if (this->every_ == 0) {
+    this->every_ = this->window_size_;
+  }
+  this->samples_.resize(this->window_size_);
+  this->times_.resize(this->window_size_);
+  this->window_.resize(this->window_size_);
+  this->re_.resize(this->window_size_);
+  this->im_.resize(this->window_size_);
+  // hann 窗
+  this->window_power_ = 0;
+  for (uint16_t i = 0; i < this->window_size_; i++) {
+    float w = 0.5f - 0.5f * cosf(2.0f * (float) M_PI * i / (this->window_size_ - 1));
+    this->window_[i] = w;
+    this->window_power_ += w * w;
+  }
+}
+
+void VibrationAnalyzer::dump_config() {
+  if (!this->is_enabled()) {
+    return;
+  }
+  ESP_LOGCONFIG(TAG, "  Vibration: axis %s, window %u, every %u samples", AXIS_NAMES[this->axis_],
+                this->window_size_, this->every_);
+  LOG_SENSOR("    ", "RMS", this->rms_sensor_);
+  LOG_SENSOR("    ", "Peak Frequency", this->peak_frequency_sensor_);
+  for (auto &band : this->bands_) {
+    ESP_LOGCONFIG(TAG, "    Band %.2f - %.2f Hz", band.low, band.high);
+    LOG_SENSOR("      ", "Energy", band.sensor);
+  }
+}
+
+void VibrationAnalyzer::add_sample(float value, uint32_t now) {
+  this->samples_[this->head_] = value;
+  this->times_[this->head_] = now;
+  this->head_ = (this->head_ + 1) % this->window_size_;
+  if (this->filled_ < this->window_size_) {
+    this->filled_++;
+  }
+  if (++this->since_last_ < this->every_ || this->filled_ < this->window_size_) {
+    return;
+  }
+  this->since_last_ = 0;
+  this->analyze_();
+}
+
+void VibrationAnalyzer::analyze_() {
+  const uint16_t n = this->window_size_;
+  // head_ 处是最老的采样, 实际采样率按窗口首尾时间戳估计
+  uint32_t span = this->times_[(this->head_ + n - 1) % n] - this->times_[this->head_];
+  if (span == 0) {
+    return;
+  }
+  float sample_rate = (n - 1) * 1000.0f / span;
+
+  float mean = 0;
+  for (uint16_t i = 0; i < n; i++) {
+    mean += this->samples_[i];
+  }
+  mean /= n;
+
+  // 去掉直流分量(重力)后加窗
+  float sum_sq = 0;
+  for (uint16_t i = 0; i < n; i++) {
+    float v = this->samples_[(this->head_ + i) % n] - mean;
+    sum_sq += v * v;
+    this->re_[i] = v * this->window_[i];
+    this->im_[i] = 0;
+  }
+  fft_(this->re_.data(), this->im_.data(), n);
+
+  // 单边功率谱, 按窗函数能量归一化, 各 bin 之和约等于均方值
+  float bin_width = sample_rate / n;
+  float peak_power = 0;
+  uint16_t peak_bin = 0;
+  for (auto &band : this->bands_) {
+    band.energy = 0;
+  }
+  for (uint16_t k = 1; k <= n / 2; k++) {
+    float power = (this->re_[k] * this->re_[k] + this->im_[k] * this->im_[k]) / (n * this->window_power_);
+    if (k != n / 2) {
+      power *= 2;
+    }
+    if (power > peak_power) {
+      peak_power = power;
+      peak_bin = k;
+    }
+    float freq = k * bin_width;
+    for (auto &band : this->bands_) {
+      if (freq >= band.low && freq < band.high) {
+        band.energy += power;
+      }
+    }
+  }
+
+  if (this->rms_sensor_ != nullptr) {
+    this->rms_sensor_->publish_state(sqrtf(sum_sq / n));
+  }
+  if (this->peak_frequency_sensor_ != nullptr) {
+    this->peak_frequency_sensor_->publish_state(peak_bin * bin_width);
+  }
+  for (auto &band : this->bands_) {
+    if (band.sensor != nullptr) {
+      band.sensor->publish_state(band.energy);
+    }
+  }
+}
+
+// 原地迭代 radix-2 FFT, n 必须是 2 的幂
+void VibrationAnalyzer::fft_(float *re, float *im, size_t n) {
+  for (size_t i = 1, j = 0; i < n; i++) {
+    size_t bit = n >> 1;
+    for (; j & bit; bit >>= 1) {
+      j ^= bit;
+    }
+    j ^= bit;
+    if (i < j) {
+      std::swap(re[i], re[j]);
+      std::swap(im[i], im[j]);
+    }
+  }
+  for (size_t len = 2; len <= n; len <<= 1) {
+    float angle = -2.0f * (float) M_PI / len;
+    float wr = cosf(angle);
+    float wi = sinf(angle);
+    for (size_t i = 0; i < n; i += len) {
+      float cr = 1.0f;
+      float ci = 0.0f;
+      for (size_t k = 0; k < len / 2; k++) {
+        size_t a = i + k;
+        size_t b = a + len / 2;
+        float tr = re[b] * cr - im[b] * ci;
+        float ti = re[b] * ci + im[b] * cr;
+        re[b] = re[a] - tr;
+        im[b] = im[a] - ti;
+        re[a] += tr;
+        im[a] += ti;
+        float next = cr * wr - ci * wi;
+        ci = cr * wi + ci * wr;
+        cr = next;
+      }
+    }
+  }
+}
+
+}  // namespace as201
+}  // namespace esphome
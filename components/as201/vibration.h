@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+#include "esphome/core/defines.h"
+#include "esphome/core/component.h"
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+
+namespace esphome {
+namespace as201 {
+
+static const size_t AS201_FFT_MAX_SIZE = 256;
+
+enum AS201VibrationAxis : uint8_t {
+  AS201_VIBRATION_AXIS_X,
+  AS201_VIBRATION_AXIS_Y,
+  AS201_VIBRATION_AXIS_Z,
+  AS201_VIBRATION_AXIS_MAGNITUDE,
+};
+
+struct VibrationBand {
+  float low;
+  float high;
+  sensor::Sensor *sensor;
+  float energy;
+};
+
+// 对加速度做加窗 FFT, 每 every 个采样输出一次 RMS, 峰值频率和各频段能量
+class VibrationAnalyzer {
+ public:
+  void set_axis(AS201VibrationAxis axis) { this->axis_ = axis; }
+  void set_window_size(uint16_t size) { this->window_size_ = size; }
+  void set_every(uint16_t every) { this->every_ = every; }
+  void set_rms_sensor(sensor::Sensor *rms_sensor) { this->rms_sensor_ = rms_sensor; }
+  void set_peak_frequency_sensor(sensor::Sensor *peak_frequency_sensor) {
+    this->peak_frequency_sensor_ = peak_frequency_sensor;
+  }
+  void add_band(float low, float high, sensor::Sensor *sensor) { this->bands_.push_back({low, high, sensor, 0}); }
+
+  bool is_enabled() const { return this->window_size_ != 0; }
+  AS201VibrationAxis get_axis() const { return this->axis_; }
+  void setup();
+  void dump_config();
+  void add_sample(float value, uint32_t now);
+
+ protected:
+  void analyze_();
+  static void fft_(float *re, float *im, size_t n);
+
+  AS201VibrationAxis axis_{AS201_VIBRATION_AXIS_Z};
+  uint16_t window_size_{0};
+  uint16_t every_{0};
+  sensor::Sensor *rms_sensor_{nullptr};
+  sensor::Sensor *peak_frequency_sensor_{nullptr};
+  std::vector<VibrationBand> bands_;
+
+  // 采样和时间戳都是环形存放, head_ 指向下一个写入位置
+  // 缓冲区在 setup() 里按 window_size 分配, 没配置 vibration 时不占内存
+  std::vector<float> samples_;
+  std::vector<uint32_t> times_;
+  std::vector<float> window_;
+  std::vector<float> re_;
+  std::vector<float> im_;
+  float window_power_{0};  // sum(w^2)
+  uint16_t head_{0};
+  uint16_t filled_{0};
+  uint16_t since_last_{0};
+};
+
+}  // namespace as201
+}  // namespace esphome
@@ -1,4 +1,5 @@
 #include "as762x.h"
+#include <algorithm>
 #include <bitset>
 #include "esphome/components/i2c/i2c.h"
 #include "esphome/core/hal.h"
@@ -12,6 +13,16 @@ static const uint8_t REG_STATUS = 0x00;  // read-only
 static const uint8_t REG_WRITE = 0x01;   // write-only
 static const uint8_t REG_READ = 0x02;    // read-only
 
+// 积分时间寄存器每一步 2.8ms
+static const float AS762X_INTEGRATION_STEP_MS = 2.8f;
+static const float AS762X_GAIN_FACTOR[] = {1.0f, 3.7f, 16.0f, 64.0f};
+// 自动增益: 16 位计数超过 CLIP 认为饱和, 低于 LOW 认为分辨率不够, 两种情况都把最大通道调到 TARGET
+static const uint16_t AS762X_RANGE_FULL = 0xFFFF;
+static const float AS762X_RANGE_CLIP = 0.9f;
+static const float AS762X_RANGE_LOW = 0.1f;
+static const float AS762X_RANGE_TARGET = 0.5f;
+static const uint8_t AS762X_RANGE_MAX_REARM = 2;
+
 static float bytes_to_float(uint32_t myLong) {
   float myFloat;
   memcpy(&myFloat, &myLong, 4);  // Copy uint8_ts into a float
@@ -35,6 +46,10 @@ void AS762XComponent::setup() {
     this->mark_failed();
     return;
   }
+  this->max_integration_time_ = std::max<uint8_t>(this->integration_time_, 1);
+  this->ref_exposure_ = AS762X_GAIN_FACTOR[this->gain_] * this->max_integration_time_;
+  // 数据就绪最长要两个积分周期, 再多留一些余量
+  this->set_retry(POLLING_DELAY * 4, AS762X_TIMEOUT / (POLLING_DELAY * 4));
   this->set_control_reg(false, this->interrupt_output_, this->gain_, this->conversion_type_);
   //  this->enable_interrupt(this->interrupt_output_);
   //  this->set_gain_reg(this->gain_);
@@ -49,7 +64,8 @@ void AS762XComponent::setup() {
 }
 
 void AS762XComponent::dump_config() {
-  ESP_LOGCONFIG(TAG, "AS762X:");
+  ESP_LOGCONFIG(TAG, "AS762X:\n"
+                     "  Auto Gain: %s", YESNO(this->auto_gain_));
   LOG_I2C_DEVICE(this);
   LOG_SENSOR("  ", "Channel 1 Sensor", this->channel_1_sensor_);
   LOG_SENSOR("  ", "Channel 2 Sensor", this->channel_2_sensor_);
@@ -69,100 +85,153 @@ void AS762XComponent::dump_config() {
   LOG_SENSOR("  ", "Calibrated DUV Sensor", this->calibrated_duv_sensor_);
   LOG_SENSOR("  ", "Calibrated Lux Sensor", this->calibrated_lux_sensor_);
   LOG_SENSOR("  ", "Calibrated CCT Sensor", this->calibrated_cct_sensor_);
+  LOG_SENSOR("  ", "Gain Sensor", this->gain_sensor_);
+  LOG_SENSOR("  ", "Integration Time Sensor", this->integration_time_sensor_);
 }
 
-void AS762XComponent::update() {
-  if (this->conversion_type_ == AS762X_CONVERSION_TYPE_3) {
-    this->clear_data_available();
-    this->set_conversion_type_reg(AS762X_CONVERSION_TYPE_3);
-    uint32_t timeout = millis() + AS762X_TIMEOUT;
-    while (!this->data_available()) {
-      // wait for data to be available
-      delay(POLLING_DELAY);
-      if (millis() > timeout) {
-        ESP_LOGW(TAG, "Timeout waiting for data to be available");
-        this->status_set_warning();
-        return;
-      }
-    }
+uint32_t AS762XComponent::conversion_time_() const {
+  float time = std::max<uint8_t>(this->integration_time_, 1) * AS762X_INTEGRATION_STEP_MS;
+  if (this->conversion_type_ == AS762X_CONVERSION_TYPE_2 || this->conversion_type_ == AS762X_CONVERSION_TYPE_3) {
+    time *= 2;
   }
-  if (this->channel_1_sensor_ != nullptr) {
-    uint16_t x = this->get_x();
-    this->channel_1_sensor_->publish_state(x);
+  return (uint32_t) time;
+}
+
+int32_t AS762XComponent::start_measurement_() {
+  if (this->integration_dirty_) {
+    this->set_integration_time_reg(this->integration_time_);
+    this->integration_dirty_ = false;
   }
-  if (this->channel_2_sensor_ != nullptr) {
-    uint16_t y = this->get_y();
-    this->channel_2_sensor_->publish_state(y);
+  // 一次写入同时更新增益和模式, 并清掉 DATA_RDY; 模式 3 下这次写入就是触发单次测量
+  if (this->set_control_reg(false, this->interrupt_output_, this->gain_, this->conversion_type_) != 0) {
+    ESP_LOGW(TAG, "AS762X trigger failed");
+    this->status_set_warning();
+    return -1;
   }
-  if (this->channel_3_sensor_ != nullptr) {
-    uint16_t z = this->get_z();
-    this->channel_3_sensor_->publish_state(z);
+  if (this->conversion_type_ == AS762X_CONVERSION_TYPE_3) {
+    this->settle_ = false;
+    return this->conversion_time_();
   }
-  if (this->channel_4_sensor_ != nullptr) {
-    uint16_t nir = this->get_nir();
-    this->channel_4_sensor_->publish_state(nir);
+  // 连续模式等下一次 DATA_RDY, 量程变了的话正在进行的那次转换不能用
+  return this->settle_ ? this->conversion_time_() : 0;
+}
+
+i2c_measure::MeasureStep AS762XComponent::read_measurement_() {
+  if (!this->data_available()) {
+    return i2c_measure::MEASURE_RETRY;
   }
-  if (this->channel_5_sensor_ != nullptr) {
-    uint16_t dark = this->get_dark();
-    this->channel_5_sensor_->publish_state(dark);
+  if (this->settle_) {
+    this->settle_ = false;
+    this->clear_data_available();
+    return i2c_measure::MEASURE_RETRY;
+  }
+
+  // 先把这次转换的值全部读出来, 再统一发布, 避免不同转换的值混在一起
+  uint16_t channels[6];
+  sensor::Sensor *channel_sensors[6] = {this->channel_1_sensor_, this->channel_2_sensor_, this->channel_3_sensor_,
+                                        this->channel_4_sensor_, this->channel_5_sensor_, this->channel_6_sensor_};
+  uint16_t peak = 0;
+  for (uint8_t i = 0; i < 6; i++) {
+    if (channel_sensors[i] != nullptr || this->auto_gain_) {
+      channels[i] = this->get_channel(AS7261_X + i * 2);
+      peak = std::max(peak, channels[i]);
+    }
   }
-  if (this->channel_6_sensor_ != nullptr) {
-    uint16_t clear = this->get_clear();
-    this->channel_6_sensor_->publish_state(clear);
+
+  AS762X_GAIN gain = this->gain_;
+  uint8_t integration_time = std::max<uint8_t>(this->integration_time_, 1);
+  if (this->auto_gain_) {
+    bool clipped = this->auto_gain_step_(peak);
+    if (clipped && this->rearm_ < AS762X_RANGE_MAX_REARM) {
+      // 饱和的值不发布, 用新的量程马上重测
+      this->rearm_++;
+      return i2c_measure::MEASURE_NEXT;
+    }
   }
-  if (this->calibrated_x_sensor_ != nullptr) {
-    float calibrated_x = this->get_calibrated_x();
-    this->calibrated_x_sensor_->publish_state(calibrated_x);
+  this->rearm_ = 0;
+
+  float calibrated[12];
+  sensor::Sensor *calibrated_sensors[12] = {
+      this->calibrated_x_sensor_,    this->calibrated_y_sensor_,     this->calibrated_z_sensor_,
+      this->calibrated_x1931_sensor_, this->calibrated_y1931_sensor_, this->calibrated_upri_sensor_,
+      this->calibrated_vpri_sensor_, this->calibrated_u_sensor_,     this->calibrated_v_sensor_,
+      this->calibrated_duv_sensor_,  this->calibrated_lux_sensor_,   this->calibrated_cct_sensor_};
+  for (uint8_t i = 0; i < 10; i++) {
+    if (calibrated_sensors[i] != nullptr) {
+      calibrated[i] = this->get_calibrated_value(AS7261_X_CAL + i * 4);
+    }
   }
-  if (this->calibrated_y_sensor_ != nullptr) {
-    float calibrated_y = this->get_calibrated_y();
-    this->calibrated_y_sensor_->publish_state(calibrated_y);
+  // LUX/CCT 是 16 位整数, 不是浮点
+  if (this->calibrated_lux_sensor_ != nullptr) {
+    calibrated[10] = this->get_channel(AS7261_LUX_CAL);
   }
-  if (this->calibrated_z_sensor_ != nullptr) {
-    float calibrated_z = this->get_calibrated_z();
-    this->calibrated_z_sensor_->publish_state(calibrated_z);
+  if (this->calibrated_cct_sensor_ != nullptr) {
+    calibrated[11] = this->get_channel(AS7261_CCT_CAL);
   }
-  if (this->calibrated_x1931_sensor_ != nullptr) {
-    float calibrated_x1931 = this->get_calibrated_x1931();
-    this->calibrated_x1931_sensor_->publish_state(calibrated_x1931);
+  uint8_t temp = 0;
+  if (this->temperature_sensor_ != nullptr) {
+    temp = this->get_temperature();
   }
-  if (this->calibrated_y1931_sensor_ != nullptr) {
-    float calibrated_y1931 = this->get_calibrated_y1931();
-    this->calibrated_y1931_sensor_->publish_state(calibrated_y1931);
+
+  // 自动增益时原始计数换算成 YAML 里增益和积分时间下的计数, 切换量程前后可以直接比较
+  float scale = 1.0f;
+  if (this->auto_gain_) {
+    scale = this->ref_exposure_ / (AS762X_GAIN_FACTOR[gain] * integration_time);
   }
-  if (this->calibrated_upri_sensor_ != nullptr) {
-    float calibrated_upri = this->get_calibrated_upri();
-    this->calibrated_upri_sensor_->publish_state(calibrated_upri);
+  for (uint8_t i = 0; i < 6; i++) {
+    if (channel_sensors[i] != nullptr) {
+      channel_sensors[i]->publish_state(channels[i] * scale);
+    }
   }
-  if (this->calibrated_vpri_sensor_ != nullptr) {
-    float calibrated_vpri = this->get_calibrated_vpri();
-    this->calibrated_vpri_sensor_->publish_state(calibrated_vpri);
+  for (uint8_t i = 0; i < 12; i++) {
+    if (calibrated_sensors[i] != nullptr) {
+      calibrated_sensors[i]->publish_state(calibrated[i]);
+    }
   }
-  if (this->calibrated_u_sensor_ != nullptr) {
-    float calibrated_u = this->get_calibrated_u();
-    this->calibrated_u_sensor_->publish_state(calibrated_u);
+  if (this->temperature_sensor_ != nullptr) {
+    this->temperature_sensor_->publish_state(temp);
   }
-  if (this->calibrated_v_sensor_ != nullptr) {
-    float calibrated_v = this->get_calibrated_v();
-    this->calibrated_v_sensor_->publish_state(calibrated_v);
+  if (this->gain_sensor_ != nullptr) {
+    this->gain_sensor_->publish_state(AS762X_GAIN_FACTOR[gain]);
   }
-  if (this->calibrated_duv_sensor_ != nullptr) {
-    float calibrated_duv = this->get_calibrated_duv();
-    this->calibrated_duv_sensor_->publish_state(calibrated_duv);
+  if (this->integration_time_sensor_ != nullptr) {
+    this->integration_time_sensor_->publish_state(integration_time * AS762X_INTEGRATION_STEP_MS);
   }
-  if (this->calibrated_lux_sensor_ != nullptr) {
-    float calibrated_lux = this->get_calibrated_lux();
-    this->calibrated_lux_sensor_->publish_state(calibrated_lux);
+  this->status_clear_warning();
+  return i2c_measure::MEASURE_DONE;
+}
+
+bool AS762XComponent::auto_gain_step_(uint16_t peak) {
+  bool clipped = peak >= AS762X_RANGE_FULL * AS762X_RANGE_CLIP;
+  if (!clipped && peak >= AS762X_RANGE_FULL * AS762X_RANGE_LOW) {
+    return false;  // 在合适的范围内, 不动
   }
-  if (this->calibrated_cct_sensor_ != nullptr) {
-    float calibrated_cct = this->get_calibrated_cct();
-    this->calibrated_cct_sensor_->publish_state(calibrated_cct);
+  float exposure = AS762X_GAIN_FACTOR[this->gain_] * std::max<uint8_t>(this->integration_time_, 1);
+  float target;
+  if (peak == AS762X_RANGE_FULL) {
+    target = exposure / 8;  // 完全饱和不知道实际有多亮, 先大幅降低
+  } else {
+    target = exposure * AS762X_RANGE_FULL * AS762X_RANGE_TARGET / std::max<uint16_t>(peak, 1);
   }
-  if (this->temperature_sensor_ != nullptr) {
-    uint8_t temp = this->get_temperature();
-    this->temperature_sensor_->publish_state(temp);
+  // 积分时间越长噪声越小, 优先用最小的增益, 积分时间不超过 YAML 里配置的值
+  uint8_t gain = AS762X_GAIN_64X;
+  for (uint8_t i = AS762X_GAIN_1X; i <= AS762X_GAIN_64X; i++) {
+    if (target / AS762X_GAIN_FACTOR[i] <= this->max_integration_time_) {
+      gain = i;
+      break;
+    }
   }
-  this->status_clear_warning();
+  float time = target / AS762X_GAIN_FACTOR[gain];
+  uint8_t integration_time = (uint8_t) std::max(1.0f, std::min(time, (float) this->max_integration_time_));
+  if (gain != this->gain_ || integration_time != this->integration_time_) {
+    this->gain_ = (AS762X_GAIN) gain;
+    this->integration_dirty_ = integration_time != this->integration_time_;
+    this->integration_time_ = integration_time;
+    this->settle_ = true;
+    ESP_LOGD(TAG, "Gain %.1fx, integration time %.1fms (peak %u)", AS762X_GAIN_FACTOR[gain],
+             integration_time * AS762X_INTEGRATION_STEP_MS, peak);
+  }
+  return clipped;
 }
 
 float AS762XComponent::get_calibrated_x() {
@@ -319,7 +388,7 @@ void AS762XComponent::clear_data_available() {
   this->write_virtual_register(AS726x_CONTROL_SETUP, config.to_ulong());
 }
 
-void AS762XComponent::set_control_reg(bool reset, bool interrupt, AS762X_GAIN gain,
+uint8_t AS762XComponent::set_control_reg(bool reset, bool interrupt, AS762X_GAIN gain,
                                       AS762X_CONVERSION_TYPE conversion_type) {
   std::bitset<8> config;
   config[7] = reset;      // Set the reset bit
@@ -360,7 +429,7 @@ void AS762XComponent::set_control_reg(bool reset, bool interrupt, AS762X_GAIN ga
       config[2] = true;
       break;
   }
-  this->write_virtual_register(AS726x_CONTROL_SETUP, config.to_ulong());
+  return this->write_virtual_register(AS726x_CONTROL_SETUP, config.to_ulong());
 }
 
 AS762X_CONVERSION_TYPE AS762XComponent::get_conversion_type_reg() {
@@ -6,6 +6,7 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
+#include "esphome/components/i2c_measure/i2c_measure.h"
 
 namespace esphome {
 namespace as762x {
@@ -103,12 +104,11 @@ enum AS762X_LED_IND_CURRENT : uint8_t {
   AS762X_LED_IND_CURRENT_8MA,  // 8 mA
 };
 
-class AS762XComponent : public PollingComponent, public i2c::I2CDevice {
+class AS762XComponent : public i2c_measure::TriggeredPollingComponent, public i2c::I2CDevice {
  public:
   void setup() override;
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
-  void update() override;
   void loop() override;
 
   void set_interrupt(bool interrupt) { this->interrupt_output_ = interrupt; }
@@ -119,6 +119,7 @@ class AS762XComponent : public PollingComponent, public i2c::I2CDevice {
   void set_led_drv(bool led_drv) { this->led_drv_ = led_drv; }
   void set_led_ind_current(AS762X_LED_IND_CURRENT current) { this->led_ind_current_ = current; }
   void set_led_ind(bool led_ind) { this->led_ind_ = led_ind; }
+  void set_auto_gain(bool auto_gain) { this->auto_gain_ = auto_gain; }
 
   void set_interrupt_pin(InternalGPIOPin *pin) { this->interrupt_pin_ = pin; }
   void set_channel_1_sensor(sensor::Sensor *channel_1_sensor) { this->channel_1_sensor_ = channel_1_sensor; }
@@ -141,10 +142,21 @@ class AS762XComponent : public PollingComponent, public i2c::I2CDevice {
   void set_calibrated_cct_sensor(sensor::Sensor *calibrated_cct_sensor) { this->calibrated_cct_sensor_ = calibrated_cct_sensor;}
 
   void set_temperature_sensor(sensor::Sensor *temperature_sensor) { this->temperature_sensor_ = temperature_sensor; }
+  void set_gain_sensor(sensor::Sensor *gain_sensor) { this->gain_sensor_ = gain_sensor; }
+  void set_integration_time_sensor(sensor::Sensor *integration_time_sensor) {
+    this->integration_time_sensor_ = integration_time_sensor;
+  }
   // for action
   void reset();
 
  protected:
+  int32_t start_measurement_() override;
+  i2c_measure::MeasureStep read_measurement_() override;
+  // 一次转换的毫秒数, 模式 2/3 要两个积分周期
+  uint32_t conversion_time_() const;
+  // 按 6 个通道里最大的计数调整下一次的增益和积分时间, 返回这次是否饱和
+  bool auto_gain_step_(uint16_t peak);
+
   bool interrupt_output_;
   AS762X_GAIN gain_;
   AS762X_CONVERSION_TYPE conversion_type_;
@@ -153,6 +165,12 @@ class AS762XComponent : public PollingComponent, public i2c::I2CDevice {
   bool led_drv_;
   AS762X_LED_IND_CURRENT led_ind_current_;
   bool led_ind_;
+  bool auto_gain_{false};
+  uint8_t max_integration_time_{255};  // 自动增益时积分时间的上限, 取 YAML 里的 integration_time
+  float ref_exposure_{1};              // YAML 里增益 x 积分时间, 原始计数换算到这个曝光量下
+  bool integration_dirty_{false};      // 积分时间改了还没写进寄存器
+  bool settle_{false};                 // 连续模式改了量程, 丢掉下一个结果
+  uint8_t rearm_{0};
 
   InternalGPIOPin *interrupt_pin_{nullptr};
   sensor::Sensor *channel_1_sensor_{nullptr};
@@ -162,6 +180,8 @@ class AS762XComponent : public PollingComponent, public i2c::I2CDevice {
   sensor::Sensor *channel_5_sensor_{nullptr};
   sensor::Sensor *channel_6_sensor_{nullptr};
   sensor::Sensor *temperature_sensor_{nullptr};
+  sensor::Sensor *gain_sensor_{nullptr};
+  sensor::Sensor *integration_time_sensor_{nullptr};
   sensor::Sensor *calibrated_x_sensor_{nullptr};  // calibrated x value
   sensor::Sensor *calibrated_y_sensor_{nullptr};
   sensor::Sensor *calibrated_z_sensor_{nullptr};
@@ -194,7 +214,7 @@ class AS762XComponent : public PollingComponent, public i2c::I2CDevice {
   AS762X_GAIN get_gain_reg();
   void set_conversion_type_reg(AS762X_CONVERSION_TYPE conversion_type);
   AS762X_CONVERSION_TYPE get_conversion_type_reg();
-  void set_control_reg(bool reset, bool interrupt, AS762X_GAIN gain, AS762X_CONVERSION_TYPE conversion_type);
+  uint8_t set_control_reg(bool reset, bool interrupt, AS762X_GAIN gain, AS762X_CONVERSION_TYPE conversion_type);
   bool data_available();
   void clear_data_available();
   void set_integration_time_reg(uint8_t time);
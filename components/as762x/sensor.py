@@ -2,13 +2,16 @@ from esphome import automation, pins
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import sensor, i2c
+from esphome.components.i2c_measure import TriggeredPollingComponent
 from esphome.const import (
     CONF_ID, CONF_INTEGRATION_TIME, ICON_BRIGHTNESS_5, CONF_GAIN, CONF_INTERRUPT_PIN, CONF_INTERRUPT,
-    DEVICE_CLASS_TEMPERATURE, STATE_CLASS_MEASUREMENT, CONF_INTERNAL_TEMPERATURE, CONF_TRIGGER_ID
+    DEVICE_CLASS_TEMPERATURE, STATE_CLASS_MEASUREMENT, CONF_INTERNAL_TEMPERATURE, CONF_TRIGGER_ID,
+    ENTITY_CATEGORY_DIAGNOSTIC, UNIT_MILLISECOND, ICON_TIMER,
 )
 
 CODEOWNERS = ["@synodriver"]
 DEPENDENCIES = ["i2c"]
+AUTO_LOAD = ["i2c_measure"]
 CONF_CONVERSION_TYPE = "conversion_type"
 CONF_LED_DRV_CURRENT = "led_drv_current"
 CONF_LED_DRV = "led_drv"
@@ -33,9 +36,12 @@ CONF_CALIBRATED_V = "calibrated_v"
 CONF_CALIBRATED_DUV = "calibrated_duv"
 CONF_CALIBRATED_LUX = "calibrated_lux"
 CONF_CALIBRATED_CCT = "calibrated_cct"
+CONF_AUTO_GAIN = "auto_gain"
+CONF_ACTUAL_GAIN = "actual_gain"
+CONF_ACTUAL_INTEGRATION_TIME = "actual_integration_time"
 
 as762x = cg.esphome_ns.namespace("as762x")
-AS762XComponent = as762x.class_("AS762XComponent", cg.PollingComponent, i2c.I2CDevice)
+AS762XComponent = as762x.class_("AS762XComponent", TriggeredPollingComponent, i2c.I2CDevice)
 
 AS762X_GAIN = as762x.enum("AS762X_GAIN")
 AS762X_GAIN_OPTIONS = {
@@ -79,6 +85,8 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_GAIN, default="64x"): cv.enum(AS762X_GAIN_OPTIONS),
             cv.Optional(CONF_CONVERSION_TYPE, default=2): cv.enum(AS762X_CONVERSION_TYPE_OPTIONS),
             cv.Optional(CONF_INTEGRATION_TIME, default=255): cv.uint8_t,
+            # 按通道计数自动调整增益和积分时间, integration_time 作为积分时间的上限
+            cv.Optional(CONF_AUTO_GAIN, default=False): cv.boolean,
             cv.Optional(CONF_LED_DRV_CURRENT, default="100mA"): cv.enum(AS762X_LED_DRV_CURRENT_OPTIONS),
             cv.Optional(CONF_LED_DRV, default=True): cv.boolean,
             cv.Optional(CONF_LED_IND_CURRENT, default="8mA"): cv.enum(AS762X_LED_IND_CURRENT_OPTIONS),
@@ -205,6 +213,18 @@ CONFIG_SCHEMA = cv.All(
                 device_class=DEVICE_CLASS_TEMPERATURE,
                 state_class=STATE_CLASS_MEASUREMENT,
             ),
+            cv.Optional(CONF_ACTUAL_GAIN): sensor.sensor_schema(
+                unit_of_measurement="x",
+                accuracy_decimals=1,
+                icon=ICON_BRIGHTNESS_5,
+                entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+            ),
+            cv.Optional(CONF_ACTUAL_INTEGRATION_TIME): sensor.sensor_schema(
+                unit_of_measurement=UNIT_MILLISECOND,
+                accuracy_decimals=1,
+                icon=ICON_TIMER,
+                entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+            ),
         }
     )
     .extend(cv.polling_component_schema("20s"))
@@ -223,6 +243,7 @@ async def to_code(config):
     cg.add(var.set_gain(config[CONF_GAIN]))
     cg.add(var.set_conversion_type(config[CONF_CONVERSION_TYPE]))
     cg.add(var.set_integration_time(config[CONF_INTEGRATION_TIME]))
+    cg.add(var.set_auto_gain(config[CONF_AUTO_GAIN]))
     cg.add(var.set_led_drv_current(config[CONF_LED_DRV_CURRENT]))
     cg.add(var.set_led_drv(config[CONF_LED_DRV]))
     cg.add(var.set_led_ind_current(config[CONF_LED_IND_CURRENT]))
@@ -291,6 +312,12 @@ async def to_code(config):
     if CONF_INTERNAL_TEMPERATURE in config:
         sens = await sensor.new_sensor(config[CONF_INTERNAL_TEMPERATURE])
         cg.add(var.set_temperature_sensor(sens))
+    if CONF_ACTUAL_GAIN in config:
+        sens = await sensor.new_sensor(config[CONF_ACTUAL_GAIN])
+        cg.add(var.set_gain_sensor(sens))
+    if CONF_ACTUAL_INTEGRATION_TIME in config:
+        sens = await sensor.new_sensor(config[CONF_ACTUAL_INTEGRATION_TIME])
+        cg.add(var.set_integration_time_sensor(sens))
 
 
 AS762XResetAction = as762x.class_("AS762XResetAction", automation.Action)
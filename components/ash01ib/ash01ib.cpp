@@ -1,4 +1,5 @@
 #include "ash01ib.h"
+#include "esphome/components/aosong_crc/aosong_crc.h"
 #include <bitset>
 #include "esphome/components/i2c/i2c.h"
 #include "esphome/core/hal.h"
@@ -18,21 +19,6 @@ const uint8_t GET_SN_CMD[2] = {0x08, 0x02};
 const uint8_t GET_VERSION_CMD[2] = {0x0A, 0x01};  // Get version command
 const uint8_t GET_UNIQUE_ID_CMD[2] = {0x0B, 0x04};  // Get unique ID command
 
-uint8_t ash01ib_crc8(const uint8_t *dat, uint8_t size) {
-  uint8_t crc = 0xFF, i;
-  for (uint8_t b = 0; b < size; b++) {
-    crc ^= (dat[b]);
-    for (i = 0; i < 8; i++) {
-      if (crc & 0x80) {
-        crc = (crc << 1) ^ 0x31;
-      } else {
-        crc <<= 1;
-      }
-    }
-  }
-  return crc;
-}
-
 void ASH01IBComponent::setup() {
   ESP_LOGCONFIG(TAG, "Running setup");
   this->start_measurement();
@@ -51,7 +37,7 @@ void ASH01IBComponent::update() {
   this->write(GET_DATA_CMD, 2);
   uint8_t data[3];
   this->read(data, 3);
-  uint8_t crc = ash01ib_crc8(data, 2);
+  uint8_t crc = aosong_crc::crc8(data, 2);
   if(crc!=data[2]) {
     ESP_LOGW(TAG, "ASH01IB CRC error: expected %02X, got %02X", crc, data[2]);
   }
@@ -82,7 +68,7 @@ STATE ASH01IBComponent::state() {
   this->write(GET_STATE_CMD, 2);
   uint8_t data[3];
   this->read(data, 3);
-  uint8_t crc = ash01ib_crc8(data, 2);
+  uint8_t crc = aosong_crc::crc8(data, 2);
   if(crc!=data[2]) {
     ESP_LOGW(TAG, "ASH01IB CRC error: expected %02X, got %02X", crc, data[2]);
     return STATE_ERROR;  // CRC error
@@ -101,7 +87,7 @@ uint16_t ASH01IBComponent::sn() {
   this->write(GET_SN_CMD, 2);
   uint8_t data[3];
   this->read(data, 3);
-  uint8_t crc = ash01ib_crc8(data, 2);
+  uint8_t crc = aosong_crc::crc8(data, 2);
   if(crc!=data[2]) {
     ESP_LOGW(TAG, "ASH01IB CRC error: expected %02X, got %02X", crc, data[2]);
     return 0;  // CRC error
@@ -114,7 +100,7 @@ uint16_t ASH01IBComponent::version() {
   this->write(GET_VERSION_CMD, 2);
   uint8_t data[3];
   this->read(data, 3);
-  uint8_t crc = ash01ib_crc8(data, 2);
+  uint8_t crc = aosong_crc::crc8(data, 2);
   if(crc!=data[2]) {
     ESP_LOGW(TAG, "ASH01IB CRC error: expected %02X, got %02X", crc, data[2]);
     return 0;  // CRC error
@@ -127,7 +113,7 @@ uint32_t ASH01IBComponent::unique_id() {
   this->write(GET_UNIQUE_ID_CMD, 2);
   uint8_t data[5];
   this->read(data, 5);
-  uint8_t crc = ash01ib_crc8(data, 4);
+  uint8_t crc = aosong_crc::crc8(data, 4);
   if(crc!=data[4]) {
     ESP_LOGW(TAG, "ASH01IB CRC error: expected %02X, got %02X", crc, data[4]);
     return 0;  // CRC error
@@ -12,6 +12,7 @@ from esphome.const import (
 
 CODEOWNERS = ["@synodriver"]
 DEPENDENCIES = ["i2c"]
+AUTO_LOAD = ["aosong_crc"]
 
 ash01ib = cg.esphome_ns.namespace("ash01ib")
 ASH01IBComponent = ash01ib.class_("ASH01IBComponent", cg.PollingComponent, i2c.I2CDevice)
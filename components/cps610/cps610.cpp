@@ -12,23 +12,42 @@ static const uint8_t REG_MEDIUM = 0x07;
 static const uint8_t REG_LOW = 0x08;
 
 
-void CPS610Component::setup() { ESP_LOGCONFIG(TAG, "Running setup"); }
+void CPS610Component::setup() {
+  ESP_LOGCONFIG(TAG, "Running setup");
+  // 转换完成前每 10ms 查一次状态, 最多等 500ms
+  this->set_retry(10, 50);
+}
+
+int32_t CPS610Component::start_measurement_() {
+  if (!this->write_byte(REG_MEASURE, 0x0A)) {
+    ESP_LOGW(TAG, "CPS610 I2C write error");
+    this->status_set_warning();
+    return -1;
+  }
+  return 50;
+}
 
-void CPS610Component::update() {
-  this->reg(REG_MEASURE) = 0x0A;
-  while (this->reg(REG_MEASURE).get() != 0x02) {
-    delay(50);
+i2c_measure::MeasureStep CPS610Component::read_measurement_() {
+  uint8_t status;
+  if (!this->read_byte(REG_MEASURE, &status)) {
+    ESP_LOGW(TAG, "CPS610 I2C read error");
+    this->status_set_warning();
+    return i2c_measure::MEASURE_DONE;
+  }
+  if (status != 0x02) {
+    return i2c_measure::MEASURE_RETRY;  // 还在转换
   }
   uint8_t read_data[3];
   if (this->write_read(&REG_HIGH, 1, read_data, 3) != i2c::ERROR_OK) {
     ESP_LOGW(TAG, "CPS610 I2C read error");
     this->status_set_warning();
-    return;
+    return i2c_measure::MEASURE_DONE;
   }
   int32_t pressure_raw = ((int32_t)read_data[0] << 16) | ((int32_t)read_data[1] << 8) | (int32_t)read_data[2];
   float pressure_kpa = (float)pressure_raw * 1.02 / 8388608.0;  // 转换为kPa
   this->pressure_sensor_->publish_state(pressure_kpa * this->a_ + this->b_);
   this->status_clear_warning();
+  return i2c_measure::MEASURE_DONE;
 }
 
 void CPS610Component::dump_config() {
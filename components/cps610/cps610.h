@@ -5,20 +5,23 @@
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
+#include "esphome/components/i2c_measure/i2c_measure.h"
 
 namespace esphome {
 namespace cps610 {
 
-class CPS610Component : public PollingComponent, public i2c::I2CDevice {
+class CPS610Component : public i2c_measure::TriggeredPollingComponent, public i2c::I2CDevice {
  public:
   float get_setup_priority() const override { return setup_priority::DATA; }
   void setup() override;
   void dump_config() override;
-  void update() override;
   void set_a(float a) { this->a_ = a; }
   void set_b(float b) { this->b_ = b; }
   void set_pressure_sensor(sensor::Sensor *pressure_sensor) { this->pressure_sensor_ = pressure_sensor; }
  protected:
+  int32_t start_measurement_() override;
+  i2c_measure::MeasureStep read_measurement_() override;
+
   float a_{1.0};
   float b_{0.0};
   sensor::Sensor *pressure_sensor_{nullptr};
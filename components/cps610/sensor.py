@@ -1,6 +1,7 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import sensor, i2c
+from esphome.components.i2c_measure import TriggeredPollingComponent
 from esphome.const import (
     CONF_ID,
     STATE_CLASS_MEASUREMENT,
@@ -9,13 +10,14 @@ from esphome.const import (
 
 CODEOWNERS = ["@synodriver"]
 DEPENDENCIES = ["i2c"]
+AUTO_LOAD = ["i2c_measure"]
 
 CONF_A = "a"
 CONF_B = "b"
 UNIT_KPASCAL = "kPa"
 
 cps610 = cg.esphome_ns.namespace("cps610")
-CPS610Component = cps610.class_("CPS610Component", cg.PollingComponent, i2c.I2CDevice)
+CPS610Component = cps610.class_("CPS610Component", TriggeredPollingComponent, i2c.I2CDevice)
 
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
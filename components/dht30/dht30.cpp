@@ -1,4 +1,5 @@
 #include "dht30.h"
+#include "esphome/components/aosong_crc/aosong_crc.h"
 #include <bitset>
 #include "esphome/components/i2c/i2c.h"
 #include "esphome/core/hal.h"
@@ -10,21 +11,6 @@ namespace dht30 {
 static const char *const TAG = "dht30";
 static const uint8_t READ_CMD[3] = {0xAC, 0x33, 0x00};  // Read command
 
-uint8_t dht30_crc8(const uint8_t *dat, uint8_t size) {
-  uint8_t crc = 0xFF, i;
-  for (uint8_t b = 0; b < size; b++) {
-    crc ^= (dat[b]);
-    for (i = 0; i < 8; i++) {
-      if (crc & 0x80) {
-        crc = (crc << 1) ^ 0x31;
-      } else {
-        crc <<= 1;
-      }
-    }
-  }
-  return crc;
-}
-
 void DHT30Component::setup() { ESP_LOGCONFIG(TAG, "Running setup"); }
 
 void DHT30Component::dump_config() {
@@ -34,24 +20,36 @@ void DHT30Component::dump_config() {
   LOG_SENSOR("  ", "Humidity Sensor", this->humidity_sensor_);
 }
 
-void DHT30Component::update() {
-  this->write(READ_CMD, 3);
+int32_t DHT30Component::start_measurement_() {
+  if (this->write(READ_CMD, 3) != i2c::ERROR_OK) {
+    ESP_LOGW(TAG, "DHT30 trigger failed");
+    this->status_set_warning();
+    return -1;
+  }
+  return 80;  // 转换时间
+}
+
+i2c_measure::MeasureStep DHT30Component::read_measurement_() {
   uint8_t data[7];
-  delay(80);
-  this->read(data, 7);
-  uint8_t crc = dht30_crc8(data, 6);
+  if (this->read(data, 7) != i2c::ERROR_OK) {
+    ESP_LOGW(TAG, "DHT30 read failed");
+    this->status_set_warning();
+    return i2c_measure::MEASURE_DONE;
+  }
+  uint8_t crc = aosong_crc::crc8(data, 6);
   if (crc != data[6]) {
     ESP_LOGW(TAG, "DHT30 CRC error: expected %02X, got %02X", crc, data[6]);
-    return;  // CRC error
+    this->status_set_warning();
+    return i2c_measure::MEASURE_DONE;
   }
 
   std::bitset<8> status = data[0];  // 状态寄存器
+  if (status[7]) {
+    return i2c_measure::MEASURE_RETRY;  // busy sensor
+  }
   if (status[2]) {
     // cmp interrupt
-    return;
-  }
-  if (status[7]) {
-    return;  // busy sensor
+    return i2c_measure::MEASURE_DONE;
   }
 
   uint32_t rh = ((uint32_t) data[1]) << 12 | ((uint32_t) data[2]) << 4 | (uint32_t) (data[3] >> 4);
@@ -64,6 +62,8 @@ void DHT30Component::update() {
   if (this->temperature_sensor_ != nullptr) {
     this->temperature_sensor_->publish_state(tempf);  // 发布温度数据
   }
+  this->status_clear_warning();
+  return i2c_measure::MEASURE_DONE;
 }
 
 }  // namespace dht30
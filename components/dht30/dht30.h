@@ -7,21 +7,24 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
+#include "esphome/components/i2c_measure/i2c_measure.h"
 
 namespace esphome {
 namespace dht30 {
 
-class DHT30Component : public PollingComponent, public i2c::I2CDevice {
+class DHT30Component : public i2c_measure::TriggeredPollingComponent, public i2c::I2CDevice {
  public:
   float get_setup_priority() const override { return setup_priority::DATA; }
   void setup() override;
   void dump_config() override;
-  void update() override;
 
   void set_temperature_sensor(sensor::Sensor *temperature_sensor) { this->temperature_sensor_ = temperature_sensor; }
   void set_humidity_sensor(sensor::Sensor *humidity_sensor) { this->humidity_sensor_ = humidity_sensor; }
 
  protected:
+  int32_t start_measurement_() override;
+  i2c_measure::MeasureStep read_measurement_() override;
+
   sensor::Sensor *temperature_sensor_{nullptr};
   sensor::Sensor *humidity_sensor_{nullptr};
 };
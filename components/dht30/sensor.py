@@ -2,6 +2,7 @@ from esphome import automation
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import sensor, i2c
+from esphome.components.i2c_measure import TriggeredPollingComponent
 from esphome.const import (
     STATE_CLASS_MEASUREMENT,
     CONF_TEMPERATURE,
@@ -16,9 +17,10 @@ from esphome.const import (
 
 CODEOWNERS = ["@synodriver"]
 DEPENDENCIES = ["i2c"]
+AUTO_LOAD = ["aosong_crc", "i2c_measure"]
 
 dht30 = cg.esphome_ns.namespace("dht30")
-DHT30Component = dht30.class_("DHT30Component", cg.PollingComponent, i2c.I2CDevice)
+DHT30Component = dht30.class_("DHT30Component", TriggeredPollingComponent, i2c.I2CDevice)
 
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
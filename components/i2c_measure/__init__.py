@@ -0,0 +1,7 @@
+# 两段式测量 (触发 -> 等待转换 -> 读取) 的公共基类, 由需要的传感器 AUTO_LOAD
+import esphome.codegen as cg
+
+CODEOWNERS = ["@synodriver"]
+
+i2c_measure_ns = cg.esphome_ns.namespace("i2c_measure")
+TriggeredPollingComponent = i2c_measure_ns.class_("TriggeredPollingComponent", cg.PollingComponent)
@@ -0,0 +1,62 @@
+#include "i2c_measure.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace i2c_measure {
+
+static const char *const TAG = "i2c_measure";
+
+void TriggeredPollingComponent::update() {
+  if (this->measuring_) {
+    // 上一次还没读完, 一般是 update_interval 比转换时间短
+    ESP_LOGV(TAG, "Measurement still in progress, skipping update");
+    return;
+  }
+  this->measuring_ = true;
+  this->busy_us_ = 0;
+  this->start_();
+}
+
+void TriggeredPollingComponent::start_() {
+  uint32_t start = micros();
+  int32_t wait = this->start_measurement_();
+  this->busy_us_ += micros() - start;
+  if (wait < 0) {
+    this->finish_(false);
+    return;
+  }
+  this->retries_ = 0;
+  this->set_timeout("measure", wait, [this]() { this->read_(); });
+}
+
+void TriggeredPollingComponent::read_() {
+  uint32_t start = micros();
+  MeasureStep step = this->read_measurement_();
+  this->busy_us_ += micros() - start;
+  switch (step) {
+    case MEASURE_DONE:
+      this->finish_(!this->status_has_warning());
+      break;
+    case MEASURE_NEXT:
+      this->start_();
+      break;
+    case MEASURE_RETRY:
+      if (++this->retries_ > this->max_retries_) {
+        ESP_LOGW(TAG, "Sensor didn't return any data, aborting");
+        this->status_set_warning();
+        this->finish_(false);
+        break;
+      }
+      this->set_timeout("measure", this->retry_interval_, [this]() { this->read_(); });
+      break;
+  }
+}
+
+void TriggeredPollingComponent::finish_(bool ok) {
+  this->measuring_ = false;
+  this->measured_callback_.call(this->busy_us_, ok);
+}
+
+}  // namespace i2c_measure
+}  // namespace esphome
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace i2c_measure {
+
+enum MeasureStep : uint8_t {
+  MEASURE_DONE,   // 本轮测量结束
+  MEASURE_RETRY,  // 数据还没准备好, 过 retry_interval 再读
+  MEASURE_NEXT,   // 立即开始下一段测量, 多通道轮流测量的传感器用
+};
+
+// update() 只发触发命令, 转换时间用 set_timeout 等待, 到时再读取发布,
+// 不在主循环里 delay 或者忙等
+class TriggeredPollingComponent : public PollingComponent {
+ public:
+  void update() override;
+
+  bool is_measuring() const { return this->measuring_; }
+  // 每轮测量结束时调用, 参数是这一轮实际占用总线的微秒数(不含等待转换)和是否成功
+  void add_on_measured_callback(std::function<void(uint32_t, bool)> &&callback) {
+    this->measured_callback_.add(std::move(callback));
+  }
+
+ protected:
+  // 触发一次测量, 返回需要等待的毫秒数, 失败返回负数
+  virtual int32_t start_measurement_() = 0;
+  virtual MeasureStep read_measurement_() = 0;
+
+  void set_retry(uint32_t interval, uint8_t max_retries) {
+    this->retry_interval_ = interval;
+    this->max_retries_ = max_retries;
+  }
+
+  void start_();
+  void read_();
+  void finish_(bool ok);
+
+  uint32_t retry_interval_{10};
+  uint8_t max_retries_{10};
+  uint8_t retries_{0};
+  bool measuring_{false};
+  uint32_t busy_us_{0};
+  LazyCallbackManager<void(uint32_t, bool)> measured_callback_;
+};
+
+}  // namespace i2c_measure
+}  // namespace esphome
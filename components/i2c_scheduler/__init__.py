@@ -0,0 +1,83 @@
+# 同一条 I2C 总线上的多个 PollingComponent 交给调度器统一轮询:
+# 按间隔错开每个设备的时隙, 每次 loop 最多轮询一个设备, 并统计每个设备的耗时和出错次数
+# 每条总线一个调度器, 两段式测量的设备读完之前不轮询其他设备
+import esphome.codegen as cg
+import esphome.config_validation as cv
+import esphome.final_validate as fv
+from esphome.components import i2c
+from esphome.const import CONF_ID, CONF_DEVICES, CONF_I2C_ID
+
+CODEOWNERS = ["@synodriver"]
+DEPENDENCIES = ["i2c"]
+AUTO_LOAD = ["i2c_measure"]
+MULTI_CONF = True
+
+CONF_MIN_GAP = "min_gap"
+CONF_STATISTICS_INTERVAL = "statistics_interval"
+
+i2c_scheduler_ns = cg.esphome_ns.namespace("i2c_scheduler")
+I2CSchedulerComponent = i2c_scheduler_ns.class_("I2CSchedulerComponent", cg.Component)
+
+
+def validate_devices(devices):
+    # 同一个设备列两次会被轮询两遍
+    seen = set()
+    for device in devices:
+        if device.id in seen:
+            raise cv.Invalid(f"Device {device.id} is listed more than once")
+        seen.add(device.id)
+    return devices
+
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(I2CSchedulerComponent),
+        cv.GenerateID(CONF_I2C_ID): cv.use_id(i2c.I2CBus),
+        cv.Required(CONF_DEVICES): cv.All(
+            cv.ensure_list(cv.use_id(cg.PollingComponent)), cv.Length(min=1), validate_devices
+        ),
+        # 两次轮询之间至少间隔多久, 避免一个 loop 里连续占用总线
+        cv.Optional(CONF_MIN_GAP, default="5ms"): cv.positive_time_period_milliseconds,
+        # 0 表示不打印统计
+        cv.Optional(CONF_STATISTICS_INTERVAL, default="60s"): cv.positive_time_period_milliseconds,
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+def _final_validate(config):
+    """列出的设备必须都挂在调度器的总线上, 每条总线和每个设备只能属于一个调度器"""
+    full_config = fv.full_config.get()
+    bus = str(config[CONF_I2C_ID])
+    for device_id in config[CONF_DEVICES]:
+        device_path = full_config.get_path_for_id(device_id)[:-1]
+        device_config = full_config.get_config_for_path(device_path)
+        device_bus = device_config.get(CONF_I2C_ID)
+        if device_bus is None:
+            raise cv.Invalid(f"Device {device_id.id} is not an I2C device", path=[CONF_DEVICES])
+        if str(device_bus) != bus:
+            raise cv.Invalid(f"Device {device_id.id} is on I2C bus {device_bus}, not {bus}", path=[CONF_DEVICES])
+    for other in full_config.get("i2c_scheduler", []):
+        if other[CONF_ID] == config[CONF_ID]:
+            continue
+        if str(other[CONF_I2C_ID]) == bus:
+            raise cv.Invalid(f"I2C bus {bus} already has a scheduler ({other[CONF_ID]})", path=[CONF_I2C_ID])
+        shared = {d.id for d in other[CONF_DEVICES]} & {d.id for d in config[CONF_DEVICES]}
+        if shared:
+            raise cv.Invalid(f"Devices {', '.join(sorted(shared))} are listed in more than one scheduler",
+                             path=[CONF_DEVICES])
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    cg.add(var.set_min_gap(config[CONF_MIN_GAP]))
+    cg.add(var.set_statistics_interval(config[CONF_STATISTICS_INTERVAL]))
+    for device_id in config[CONF_DEVICES]:
+        device = await cg.get_variable(device_id)
+        # TriggeredPollingComponent 的设备在 C++ 里按重载自动走两段式测量的路径
+        cg.add(var.add_device(device, str(device_id)))
@@ -0,0 +1,159 @@
+#include "i2c_scheduler.h"
+#include <algorithm>
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace i2c_scheduler {
+
+static const char *const TAG = "i2c_scheduler";
+
+void I2CSchedulerComponent::setup() {
+  // 最短的间隔平均分给所有设备, 第 i 个设备从第 i 个时隙开始
+  uint32_t min_interval = UINT32_MAX;
+  for (auto &device : this->devices_) {
+    uint32_t interval = device.component->get_update_interval();
+    if (interval != SCHEDULER_DONT_RUN) {
+      min_interval = std::min(min_interval, interval);
+    }
+  }
+  uint32_t slot = min_interval == UINT32_MAX ? 0 : min_interval / this->devices_.size();
+  uint32_t now = millis();
+  for (size_t i = 0; i < this->devices_.size(); i++) {
+    Device &device = this->devices_[i];
+    if (device.component->get_update_interval() == SCHEDULER_DONT_RUN) {
+      continue;  // 只手动 update 的设备不接管
+    }
+    device.component->stop_poller();
+    device.next_run = now + slot * i;
+    if (device.measure != nullptr) {
+      device.measure->add_on_measured_callback(
+          [this, &device](uint32_t busy_us, bool ok) { this->on_measured_(device, busy_us, ok); });
+    }
+  }
+  if (this->statistics_interval_ > 0) {
+    this->set_interval("statistics", this->statistics_interval_, [this]() { this->log_statistics_(); });
+  }
+}
+
+void I2CSchedulerComponent::loop() {
+  uint32_t now = millis();
+  if (this->busy_ != nullptr) {
+    if (this->busy_->measure->is_measuring()) {
+      return;  // 两段式测量还没读完, 总线留给它
+    }
+    // 正常情况下结束回调已经清掉了 busy_, 这里只是兜底
+    this->busy_->in_flight = false;
+    this->busy_ = nullptr;
+  }
+  if (now - this->last_run_ < this->min_gap_) {
+    return;
+  }
+  // 到期的设备里取等得最久的一个, 其余的留到后面的 loop
+  Device *due = nullptr;
+  int32_t max_late = -1;
+  for (auto &device : this->devices_) {
+    if (device.component->get_update_interval() == SCHEDULER_DONT_RUN) {
+      continue;
+    }
+    int32_t late = (int32_t) (now - device.next_run);
+    if (late > max_late) {
+      max_late = late;
+      due = &device;
+    }
+  }
+  if (due != nullptr) {
+    this->run_(*due, now);
+  }
+}
+
+void I2CSchedulerComponent::run_(Device &device, uint32_t now) {
+  if (device.component->is_failed()) {
+    device.next_run = now + device.component->get_update_interval();
+    return;
+  }
+  if (device.measure != nullptr) {
+    if (device.measure->is_measuring()) {
+      // 别处(比如 component.update 动作)触发的测量还没结束, 它的结果就是这一次的结果
+      device.deduped++;
+      this->advance_(device, now);
+      return;
+    }
+    // 先标记, 触发失败时结束回调会在 update() 里同步调用
+    device.in_flight = true;
+    this->busy_ = &device;
+    device.component->update();
+    this->last_run_ = millis();
+    this->advance_(device, now);
+    return;
+  }
+  uint32_t start = micros();
+  device.component->update();
+  uint32_t elapsed = micros() - start;
+  this->last_run_ = millis();
+  this->record_(device, elapsed, !device.component->status_has_warning());
+  this->advance_(device, now);
+}
+
+void I2CSchedulerComponent::on_measured_(Device &device, uint32_t busy_us, bool ok) {
+  if (!device.in_flight) {
+    // 不是调度器触发的测量, 刚读过的数据不再重复读, 下一次轮询顺延一个间隔
+    device.deduped++;
+    device.next_run = millis() + device.component->get_update_interval();
+    return;
+  }
+  device.in_flight = false;
+  if (this->busy_ == &device) {
+    this->busy_ = nullptr;
+  }
+  this->last_run_ = millis();
+  this->record_(device, busy_us, ok);
+}
+
+void I2CSchedulerComponent::record_(Device &device, uint32_t elapsed_us, bool ok) {
+  device.runs++;
+  device.total_us += elapsed_us;
+  device.max_us = std::max(device.max_us, elapsed_us);
+  if (!ok) {
+    device.errors++;
+  }
+}
+
+void I2CSchedulerComponent::advance_(Device &device, uint32_t now) {
+  uint32_t interval = device.component->get_update_interval();
+  device.next_run += interval;
+  if ((int32_t) (now - device.next_run) >= 0) {
+    // 落后超过一个间隔时不补跑, 多出来的时隙合并成这一次
+    device.coalesced += (now - device.next_run) / interval + 1;
+    device.next_run = now + interval;
+  }
+}
+
+void I2CSchedulerComponent::log_statistics_() {
+  for (auto &device : this->devices_) {
+    ESP_LOGD(TAG, "%s: %" PRIu32 " runs, %" PRIu32 " errors, %" PRIu32 " coalesced, %" PRIu32 " deduped, avg %" PRIu32
+                  " us, max %" PRIu32 " us",
+             device.name, device.runs, device.errors, device.coalesced, device.deduped,
+             device.runs > 0 ? device.total_us / device.runs : 0, device.max_us);
+    device.runs = 0;
+    device.errors = 0;
+    device.coalesced = 0;
+    device.deduped = 0;
+    device.total_us = 0;
+    device.max_us = 0;
+  }
+}
+
+void I2CSchedulerComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "I2C Scheduler:\n"
+                "  Min Gap: %" PRIu32 " ms\n"
+                "  Statistics Interval: %" PRIu32 " ms",
+                this->min_gap_, this->statistics_interval_);
+  for (auto &device : this->devices_) {
+    ESP_LOGCONFIG(TAG, "  Device: %s, interval %" PRIu32 " ms%s", device.name, device.component->get_update_interval(),
+                  device.measure != nullptr ? ", triggered" : "");
+  }
+}
+
+}  // namespace i2c_scheduler
+}  // namespace esphome
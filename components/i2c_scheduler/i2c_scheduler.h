@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+#include "esphome/core/component.h"
+#include "esphome/components/i2c_measure/i2c_measure.h"
+
+namespace esphome {
+namespace i2c_scheduler {
+
+class I2CSchedulerComponent : public Component {
+ public:
+  // 在所有设备 setup 之后接管它们的轮询
+  float get_setup_priority() const override { return setup_priority::LATE; }
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+
+  void add_device(PollingComponent *component, const char *name) { this->devices_.push_back({component, nullptr, name}); }
+  // 两段式测量的设备, update() 只发触发命令, 读取结束才算这次轮询完成
+  void add_device(i2c_measure::TriggeredPollingComponent *component, const char *name) {
+    this->devices_.push_back({component, component, name});
+  }
+  void set_min_gap(uint32_t min_gap) { this->min_gap_ = min_gap; }
+  void set_statistics_interval(uint32_t interval) { this->statistics_interval_ = interval; }
+
+ protected:
+  struct Device {
+    PollingComponent *component;
+    i2c_measure::TriggeredPollingComponent *measure;  // 不是两段式测量时为 nullptr
+    const char *name;
+    uint32_t next_run{0};
+    bool in_flight{false};  // 由调度器触发的测量还没读完
+    // 统计, 每个 statistics_interval 清零
+    uint32_t runs{0};
+    uint32_t errors{0};     // 轮询结束时处于 warning 状态或者读取失败的次数
+    uint32_t coalesced{0};  // 错过时隙被合并掉的轮询次数
+    uint32_t deduped{0};    // 设备刚被别处读过或者正在测量, 跳过的轮询次数
+    uint32_t total_us{0};   // 占用总线的时间, 两段式测量不含等待转换的时间
+    uint32_t max_us{0};
+  };
+
+  void run_(Device &device, uint32_t now);
+  void record_(Device &device, uint32_t elapsed_us, bool ok);
+  void on_measured_(Device &device, uint32_t busy_us, bool ok);
+  void advance_(Device &device, uint32_t now);
+  void log_statistics_();
+
+  std::vector<Device> devices_;
+  Device *busy_{nullptr};  // 正在测量的两段式设备, 读完之前不轮询其他设备
+  uint32_t min_gap_{5};
+  uint32_t statistics_interval_{60000};
+  uint32_t last_run_{0};
+};
+
+}  // namespace i2c_scheduler
+}  // namespace esphome
@@ -0,0 +1,80 @@
+#include "filter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace esphome {
+namespace ld2413 {
+
+float LD2413Filter::process(float value) {
+  if (!std::isfinite(value)) {
+    return value;
+  }
+  if (this->window_ > 1) {
+    value = this->median_(value);
+  }
+  if (this->measurement_noise_ > 0) {
+    value = this->kalman_(value);
+  }
+  return value;
+}
+
+float LD2413Filter::median_(float value) {
+  auto begin = this->sorted_.begin();
+  if (this->count_ == this->window_) {
+    // 窗口满了, 从有序数组里删掉最旧的值
+    float oldest = this->ring_[this->pos_];
+    auto it = std::lower_bound(begin, begin + this->count_, oldest);
+    std::copy(it + 1, begin + this->count_, it);
+    this->count_--;
+  }
+  // 二分查找插入位置
+  auto it = std::upper_bound(begin, begin + this->count_, value);
+  std::copy_backward(it, begin + this->count_, begin + this->count_ + 1);
+  *it = value;
+  this->count_++;
+  this->ring_[this->pos_] = value;
+  this->pos_ = (this->pos_ + 1) % this->window_;
+  if (this->count_ % 2 == 1) {
+    return this->sorted_[this->count_ / 2];
+  }
+  return (this->sorted_[this->count_ / 2 - 1] + this->sorted_[this->count_ / 2]) / 2;
+}
+
+float LD2413Filter::kalman_(float value) {
+  // 液位按随机游走建模, 每帧方差增加 process_noise^2
+  float r = this->measurement_noise_ * this->measurement_noise_;
+  if (this->error_ < 0) {
+    this->estimate_ = value;
+    this->error_ = r;
+    return value;
+  }
+  this->error_ += this->process_noise_ * this->process_noise_;
+  float gain = this->error_ / (this->error_ + r);
+  this->estimate_ += gain * (value - this->estimate_);
+  this->error_ *= 1 - gain;
+  return this->estimate_;
+}
+
+bool LD2413Filter::should_publish(float value) {
+  if (++this->skipped_ < this->every_) {
+    return false;
+  }
+  this->skipped_ = 0;
+  if (this->has_published_ && std::fabs(value - this->published_) < this->delta_) {
+    return false;
+  }
+  this->published_ = value;
+  this->has_published_ = true;
+  return true;
+}
+
+void LD2413Filter::reset() {
+  this->count_ = 0;
+  this->pos_ = 0;
+  this->error_ = -1;
+  this->skipped_ = 0;
+  this->has_published_ = false;
+}
+
+}  // namespace ld2413
+}  // namespace esphome
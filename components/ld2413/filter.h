@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace esphome {
+namespace ld2413 {
+
+static const uint8_t LD2413_MEDIAN_MAX_WINDOW = 31;
+
+// 距离帧的处理链: 滑动中值 -> 一维卡尔曼 -> 抽取, 各级都可以单独关闭
+class LD2413Filter {
+ public:
+  void set_median_window(uint8_t window) { this->window_ = window; }
+  void set_kalman(float process_noise, float measurement_noise) {
+    this->process_noise_ = process_noise;
+    this->measurement_noise_ = measurement_noise;
+  }
+  void set_decimation(uint16_t every, float delta) {
+    this->every_ = every;
+    this->delta_ = delta;
+  }
+
+  // 返回滤波后的值
+  float process(float value);
+  // 抽取: 每 every 个值检查一次, 与上次发布的值相差不到 delta 时不发布
+  bool should_publish(float value);
+  void reset();
+
+ protected:
+  float median_(float value);
+  float kalman_(float value);
+
+  uint8_t window_{1};
+  std::array<float, LD2413_MEDIAN_MAX_WINDOW> ring_{};    // 按到达顺序, 用于淘汰最旧的值
+  std::array<float, LD2413_MEDIAN_MAX_WINDOW> sorted_{};  // 窗口内的值排好序
+  uint8_t count_{0};
+  uint8_t pos_{0};
+
+  float process_noise_{0};
+  float measurement_noise_{0};  // 0 表示不使用卡尔曼
+  float estimate_{0};
+  float error_{-1};  // 负数表示还没初始化
+
+  uint16_t every_{1};
+  float delta_{0};
+  uint16_t skipped_{0};
+  float published_{0};
+  bool has_published_{false};
+};
+
+}  // namespace ld2413
+}  // namespace esphome
@@ -1,5 +1,7 @@
 #include "ld2413.h"
 #include "esphome/core/log.h"
+#include "esphome/core/hal.h"
+#include <cmath>
 
 namespace esphome {
 namespace ld2413 {
@@ -35,6 +37,7 @@ void LD2413Component::dump_config() {
   ESP_LOGCONFIG(TAG, "  Min Distance: %d mm", this->min_distance_);
   ESP_LOGCONFIG(TAG, "  Max Distance: %d mm", this->max_distance_);
   LOG_SENSOR("  ", "Distance Sensor", this->distance_sensor_);
+  LOG_SENSOR("  ", "Rate Sensor", this->rate_sensor_);
   this->check_uart_settings(115200);
 }
 
@@ -70,12 +73,37 @@ void LD2413Component::loop() {
   uint8_t *ptr = this->receive_buffer.data() + 6;
   float value;
   memcpy(&value, ptr, 4);
-  if (this->distance_sensor_ != nullptr) {
+  value = this->filter_.process(value);
+  if (this->distance_sensor_ != nullptr && this->filter_.should_publish(value)) {
     this->distance_sensor_->publish_state(value);
   }
+  if (this->trend_enabled_) {
+    this->update_trend_(value);
+  }
   this->receive_buffer.erase(this->receive_buffer.begin(), this->receive_buffer.begin() + 14);
 }
 
+void LD2413Component::update_trend_(float value) {
+  LD2413Event event = this->trend_.update(value, millis());
+  if (!this->trend_.has_rate()) {
+    return;
+  }
+  float rate = this->trend_.get_rate();
+  if (event != LD2413_EVENT_NONE) {
+    ESP_LOGD(TAG, "Level event %u, rate %.2f mm/min", event, rate);
+    this->event_callback_.call(event, rate);
+  }
+  if (this->rate_sensor_ != nullptr &&
+      (!this->rate_sensor_->has_state() || std::fabs(rate - this->rate_sensor_->state) >= this->rate_delta_)) {
+    this->rate_sensor_->publish_state(rate);
+  }
+}
+
+void LD2413Component::reset_history_() {
+  this->filter_.reset();
+  this->trend_.reset();
+}
+
 uint32_t LD2413Component::get_report_interval() {
   uint16_t ret_command, status;
   std::string value;
@@ -94,7 +122,9 @@ void LD2413Component::set_report_interval(uint16_t interval) {
   this->send_command(SET_REPORT_INTERVAL, this->send_buffer, 2, &ret_command, &status, nullptr);
   if (status != 0) {
     this->status_set_warning();
+    return;
   }
+  this->reset_history_();
 }
 
 void LD2413Component::update_door_limit() {
@@ -113,7 +143,9 @@ void LD2413Component::set_min_distance(uint16_t min_distance) {
   this->send_command(MIN_DISTANCE, this->send_buffer, 2, &ret_command, &status, nullptr);
   if (status != 0) {
     this->status_set_warning();
+    return;
   }
+  this->reset_history_();
 }
 
 // unit: mm 150-10500
@@ -124,7 +156,9 @@ void LD2413Component::set_max_distance(uint16_t max_distance) {
   this->send_command(MAX_DISTANCE, this->send_buffer, 2, &ret_command, &status, nullptr);
   if (status != 0) {
     this->status_set_warning();
+    return;
   }
+  this->reset_history_();
 }
 
 void LD2413Component::disable_config() {
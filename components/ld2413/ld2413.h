@@ -5,6 +5,8 @@
 #include "esphome/core/automation.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/uart/uart.h"
+#include "filter.h"
+#include "trend.h"
 
 namespace esphome {
 namespace ld2413 {
@@ -20,6 +22,14 @@ class LD2413Component : public Component, public uart::UARTDevice {
   void set_update_interval(uint16_t update_interval) { this->update_interval_ = update_interval; }
   void set_max_distance_attr(uint16_t max_distance) { this->max_distance_ = max_distance; }
   void set_min_distance_attr(uint16_t min_distance) { this->min_distance_ = min_distance; }
+  LD2413Filter &get_filter() { return this->filter_; }
+  void set_rate_sensor(sensor::Sensor *rate_sensor) { this->rate_sensor_ = rate_sensor; }
+  void set_trend_enabled(bool enabled) { this->trend_enabled_ = enabled; }
+  void set_rate_delta(float rate_delta) { this->rate_delta_ = rate_delta; }
+  LD2413Trend &get_trend() { return this->trend_; }
+  void add_on_event_callback(std::function<void(LD2413Event, float)> &&callback) {
+    this->event_callback_.add(std::move(callback));
+  }
   // action
   void update_door_limit();
   void set_max_distance(uint16_t max_distance);
@@ -32,6 +42,16 @@ class LD2413Component : public Component, public uart::UARTDevice {
   uint16_t update_interval_;
   uint16_t max_distance_;
   uint16_t min_distance_;
+  LD2413Filter filter_;
+  sensor::Sensor *rate_sensor_{nullptr};
+  bool trend_enabled_{false};
+  float rate_delta_{0.5f};  // mm/min
+  LD2413Trend trend_;
+  LazyCallbackManager<void(LD2413Event, float)> event_callback_;
+
+  void update_trend_(float value);
+  // 测距范围或上报间隔改变后, 之前的历史不再可比
+  void reset_history_();
 
   uint32_t get_report_interval();
   std::string version();
@@ -103,5 +123,17 @@ template<typename... Ts> class LD2413SetReportIntervalAction : public Action<Ts.
   LD2413Component *ld2413_;
 };
 
+// 参数为触发时的液位变化速率 mm/min
+class LD2413EventTrigger : public Trigger<float> {
+ public:
+  LD2413EventTrigger(LD2413Component *parent, LD2413Event event) {
+    parent->add_on_event_callback([this, event](LD2413Event e, float rate) {
+      if (e == event) {
+        this->trigger(rate);
+      }
+    });
+  }
+};
+
 }
 }
\ No newline at end of file
@@ -7,6 +7,7 @@ from esphome.const import (
     CONF_ID,
     CONF_UPDATE_INTERVAL,
     CONF_DISTANCE,
+    CONF_TRIGGER_ID,
     STATE_CLASS_MEASUREMENT, UNIT_MILLIMETER, DEVICE_CLASS_DISTANCE
 )
 
@@ -14,9 +15,53 @@ CODEOWNERS = ["@synodriver"]
 DEPENDENCIES = ["uart"]
 CONF_MAX_DISTANCE = "max_distance"
 CONF_MIN_DISTANCE = "min_distance"
+CONF_SMOOTHING = "smoothing"
+CONF_MEDIAN_WINDOW = "median_window"
+CONF_KALMAN = "kalman"
+CONF_PROCESS_NOISE = "process_noise"
+CONF_MEASUREMENT_NOISE = "measurement_noise"
+CONF_EVERY = "every"
+CONF_DELTA = "delta"
+CONF_TREND = "trend"
+CONF_WINDOW = "window"
+CONF_RATE = "rate"
+CONF_RATE_DELTA = "rate_delta"
+CONF_FILL_RATE = "fill_rate"
+CONF_DRAIN_RATE = "drain_rate"
+CONF_LEAK_RATE = "leak_rate"
+CONF_LEAK_DURATION = "leak_duration"
+CONF_ON_FILL = "on_fill"
+CONF_ON_DRAIN = "on_drain"
+CONF_ON_LEAK = "on_leak"
+UNIT_MILLIMETER_PER_MINUTE = "mm/min"
 
 ld2413 = cg.esphome_ns.namespace("ld2413")
 LD2413Component = ld2413.class_("LD2413Component", cg.Component, uart.UARTDevice)
+LD2413Event = ld2413.enum("LD2413Event")
+LD2413EventTrigger = ld2413.class_("LD2413EventTrigger", automation.Trigger.template(cg.float_))
+
+# 事件 -> (阈值配置项, C++ 枚举)
+TREND_EVENTS = {
+    CONF_ON_FILL: (CONF_FILL_RATE, LD2413Event.LD2413_EVENT_FILL),
+    CONF_ON_DRAIN: (CONF_DRAIN_RATE, LD2413Event.LD2413_EVENT_DRAIN),
+    CONF_ON_LEAK: (CONF_LEAK_RATE, LD2413Event.LD2413_EVENT_LEAK),
+}
+
+
+def validate_trend(config):
+    for event, (threshold, _) in TREND_EVENTS.items():
+        if event in config and threshold not in config:
+            raise cv.Invalid(f"'{event}' requires '{threshold}'")
+    return config
+
+
+def event_automation():
+    return automation.validate_automation(
+        {
+            cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(LD2413EventTrigger),
+        }
+    )
+
 
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
@@ -31,6 +76,45 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_MAX_DISTANCE, default=10500): cv.positive_int,
             cv.Optional(CONF_MIN_DISTANCE, default=0): cv.positive_int,
             cv.Optional(CONF_UPDATE_INTERVAL, default="20s"): cv.positive_time_period_milliseconds,
+            # 在组件内先滤波再发布, 雷达可以用较短的上报间隔而不会刷屏
+            cv.Optional(CONF_SMOOTHING): cv.Schema(
+                {
+                    cv.Optional(CONF_MEDIAN_WINDOW, default=1): cv.int_range(min=1, max=31),
+                    cv.Optional(CONF_KALMAN): cv.Schema(
+                        {
+                            cv.Optional(CONF_PROCESS_NOISE, default=1.0): cv.positive_float,  # mm/帧
+                            cv.Required(CONF_MEASUREMENT_NOISE): cv.float_range(min=0, min_included=False),  # mm
+                        }
+                    ),
+                    cv.Optional(CONF_EVERY, default=1): cv.int_range(min=1, max=65535),
+                    cv.Optional(CONF_DELTA, default=0): cv.positive_float,  # mm
+                }
+            ),
+            # 对窗口内的距离做线性回归得到液位变化速率, 正数表示上涨
+            cv.Optional(CONF_TREND): cv.All(
+                cv.Schema(
+                    {
+                        cv.Optional(CONF_WINDOW, default="5min"): cv.All(
+                            cv.positive_time_period_milliseconds,
+                            cv.Range(min=cv.TimePeriod(seconds=10), max=cv.TimePeriod(hours=6)),
+                        ),
+                        cv.Optional(CONF_RATE): sensor.sensor_schema(
+                            unit_of_measurement=UNIT_MILLIMETER_PER_MINUTE,
+                            accuracy_decimals=2,
+                            state_class=STATE_CLASS_MEASUREMENT,
+                        ),
+                        cv.Optional(CONF_RATE_DELTA, default=0.5): cv.positive_float,  # mm/min
+                        cv.Optional(CONF_FILL_RATE): cv.float_range(min=0, min_included=False),  # mm/min
+                        cv.Optional(CONF_DRAIN_RATE): cv.float_range(min=0, min_included=False),  # mm/min
+                        cv.Optional(CONF_LEAK_RATE): cv.float_range(min=0, min_included=False),  # mm/min
+                        cv.Optional(CONF_LEAK_DURATION, default="30min"): cv.positive_time_period_milliseconds,
+                        cv.Optional(CONF_ON_FILL): event_automation(),
+                        cv.Optional(CONF_ON_DRAIN): event_automation(),
+                        cv.Optional(CONF_ON_LEAK): event_automation(),
+                    }
+                ),
+                validate_trend,
+            ),
         }
     )
     .extend(cv.COMPONENT_SCHEMA)
@@ -53,9 +137,33 @@ async def to_code(config):
     cg.add(var.set_max_distance_attr(config[CONF_MAX_DISTANCE]))
     cg.add(var.set_min_distance_attr(config[CONF_MIN_DISTANCE]))
     cg.add(var.set_update_interval(config[CONF_UPDATE_INTERVAL]))
+    if smoothing_config := config.get(CONF_SMOOTHING):
+        filter_ = var.get_filter()
+        cg.add(filter_.set_median_window(smoothing_config[CONF_MEDIAN_WINDOW]))
+        if kalman_config := smoothing_config.get(CONF_KALMAN):
+            cg.add(filter_.set_kalman(kalman_config[CONF_PROCESS_NOISE], kalman_config[CONF_MEASUREMENT_NOISE]))
+        cg.add(filter_.set_decimation(smoothing_config[CONF_EVERY], smoothing_config[CONF_DELTA]))
     if CONF_DISTANCE in config:
         sens = await sensor.new_sensor(config[CONF_DISTANCE])
         cg.add(var.set_distance_sensor(sens))
+    if trend_config := config.get(CONF_TREND):
+        trend = var.get_trend()
+        cg.add(var.set_trend_enabled(True))
+        cg.add(trend.set_window(trend_config[CONF_WINDOW]))
+        if CONF_FILL_RATE in trend_config:
+            cg.add(trend.set_fill_rate(trend_config[CONF_FILL_RATE]))
+        if CONF_DRAIN_RATE in trend_config:
+            cg.add(trend.set_drain_rate(trend_config[CONF_DRAIN_RATE]))
+        if CONF_LEAK_RATE in trend_config:
+            cg.add(trend.set_leak(trend_config[CONF_LEAK_RATE], trend_config[CONF_LEAK_DURATION]))
+        cg.add(var.set_rate_delta(trend_config[CONF_RATE_DELTA]))
+        if CONF_RATE in trend_config:
+            sens = await sensor.new_sensor(trend_config[CONF_RATE])
+            cg.add(var.set_rate_sensor(sens))
+        for event, (_, event_enum) in TREND_EVENTS.items():
+            for conf in trend_config.get(event, []):
+                trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var, event_enum)
+                await automation.build_automation(trigger, [(cg.float_, "rate")], conf)
 
 
 LD2413UpdateDoorLimitAction = ld2413.class_("LD2413UpdateDoorLimitAction", automation.Action)
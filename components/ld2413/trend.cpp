@@ -0,0 +1,125 @@
+#include "trend.h"
+#include <cmath>
+
+namespace esphome {
+namespace ld2413 {
+
+static const uint8_t LD2413_TREND_MIN_SAMPLES = 3;
+// 最旧样本离 base_ 超过这个秒数就重新取基准, 保证 float 时间和累加和的精度
+static const float LD2413_TREND_REBASE = 3600.0f;
+
+LD2413Event LD2413Trend::update(float distance, uint32_t now) {
+  if (!std::isfinite(distance)) {
+    return LD2413_EVENT_NONE;
+  }
+  if (this->count_ == 0) {
+    this->base_ = now;
+  } else if (this->history_[this->head_].t > LD2413_TREND_REBASE) {
+    this->rebase_();
+  }
+  float t = (now - this->base_) / 1000.0f;
+  float window = this->window_ / 1000.0f;
+  // 上报间隔很短时按窗口等间隔取样, 让环形缓冲覆盖整个窗口
+  if (this->count_ > 0) {
+    const Sample &last = this->history_[(this->head_ + this->count_ - 1) % LD2413_HISTORY_SIZE];
+    if (t - last.t < window / (LD2413_HISTORY_SIZE - 1)) {
+      return LD2413_EVENT_NONE;
+    }
+  }
+  // 淘汰窗口外和放不下的旧样本
+  while (this->count_ > 0 &&
+         (this->count_ == LD2413_HISTORY_SIZE || t - this->history_[this->head_].t > window)) {
+    this->pop_();
+  }
+  this->push_(t, distance);
+
+  double n = this->count_;
+  double denom = n * this->sum_tt_ - this->sum_t_ * this->sum_t_;
+  const Sample &oldest = this->history_[this->head_];
+  // 至少覆盖窗口的一半才认为速率可信
+  this->valid_ = this->count_ >= LD2413_TREND_MIN_SAMPLES && t - oldest.t >= window / 2 && denom > 0;
+  if (!this->valid_) {
+    return LD2413_EVENT_NONE;
+  }
+  double slope = (n * this->sum_td_ - this->sum_t_ * this->sum_d_) / denom;  // mm/s
+  this->rate_ = (float) (-slope * 60);
+  return this->classify_(now);
+}
+
+void LD2413Trend::push_(float t, float distance) {
+  uint8_t tail = (this->head_ + this->count_) % LD2413_HISTORY_SIZE;
+  this->history_[tail] = {t, distance};
+  this->count_++;
+  this->sum_t_ += t;
+  this->sum_d_ += distance;
+  this->sum_tt_ += (double) t * t;
+  this->sum_td_ += (double) t * distance;
+}
+
+void LD2413Trend::pop_() {
+  const Sample &s = this->history_[this->head_];
+  this->sum_t_ -= s.t;
+  this->sum_d_ -= s.distance;
+  this->sum_tt_ -= (double) s.t * s.t;
+  this->sum_td_ -= (double) s.t * s.distance;
+  this->head_ = (this->head_ + 1) % LD2413_HISTORY_SIZE;
+  this->count_--;
+}
+
+void LD2413Trend::rebase_() {
+  uint32_t shift_ms = (uint32_t) (this->history_[this->head_].t * 1000);
+  float shift = shift_ms / 1000.0f;
+  this->base_ += shift_ms;
+  this->sum_t_ = this->sum_d_ = this->sum_tt_ = this->sum_td_ = 0;
+  for (uint8_t i = 0; i < this->count_; i++) {
+    Sample &s = this->history_[(this->head_ + i) % LD2413_HISTORY_SIZE];
+    s.t -= shift;
+    this->sum_t_ += s.t;
+    this->sum_d_ += s.distance;
+    this->sum_tt_ += (double) s.t * s.t;
+    this->sum_td_ += (double) s.t * s.distance;
+  }
+}
+
+LD2413Event LD2413Trend::classify_(uint32_t now) {
+  // 进入状态按阈值, 退出按一半阈值, 避免在阈值附近反复触发
+  LD2413Event state = this->state_;
+  if (this->fill_rate_ > 0 && this->rate_ >= this->fill_rate_) {
+    state = LD2413_EVENT_FILL;
+  } else if (this->drain_rate_ > 0 && this->rate_ <= -this->drain_rate_) {
+    state = LD2413_EVENT_DRAIN;
+  } else if ((state == LD2413_EVENT_FILL && this->rate_ < this->fill_rate_ / 2) ||
+             (state == LD2413_EVENT_DRAIN && this->rate_ > -this->drain_rate_ / 2)) {
+    state = LD2413_EVENT_NONE;
+  }
+  LD2413Event event = state != this->state_ ? state : LD2413_EVENT_NONE;
+  this->state_ = state;
+
+  // 漏水: 没有在放水, 但液位持续缓慢下降超过 leak_duration
+  if (this->leak_rate_ > 0 && state == LD2413_EVENT_NONE && this->rate_ <= -this->leak_rate_) {
+    if (this->leak_since_ == 0) {
+      this->leak_since_ = now;
+    }
+    if (!this->leak_reported_ && now - this->leak_since_ >= this->leak_duration_) {
+      this->leak_reported_ = true;
+      return LD2413_EVENT_LEAK;
+    }
+  } else if (state != LD2413_EVENT_NONE || this->rate_ > -this->leak_rate_ / 2) {
+    this->leak_since_ = 0;
+    this->leak_reported_ = false;
+  }
+  return event;
+}
+
+void LD2413Trend::reset() {
+  this->head_ = 0;
+  this->count_ = 0;
+  this->sum_t_ = this->sum_d_ = this->sum_tt_ = this->sum_td_ = 0;
+  this->valid_ = false;
+  this->state_ = LD2413_EVENT_NONE;
+  this->leak_since_ = 0;
+  this->leak_reported_ = false;
+}
+
+}  // namespace ld2413
+}  // namespace esphome
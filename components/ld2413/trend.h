@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace esphome {
+namespace ld2413 {
+
+static const uint8_t LD2413_HISTORY_SIZE = 64;
+
+enum LD2413Event : uint8_t {
+  LD2413_EVENT_NONE = 0,
+  LD2413_EVENT_FILL,
+  LD2413_EVENT_DRAIN,
+  LD2413_EVENT_LEAK,
+};
+
+// 在时间窗口内对 (时间, 距离) 做线性回归得到液位变化速率, 速率越过阈值时产生事件
+class LD2413Trend {
+ public:
+  void set_window(uint32_t window) { this->window_ = window; }
+  void set_fill_rate(float rate) { this->fill_rate_ = rate; }
+  void set_drain_rate(float rate) { this->drain_rate_ = rate; }
+  void set_leak(float rate, uint32_t duration) {
+    this->leak_rate_ = rate;
+    this->leak_duration_ = duration;
+  }
+
+  // distance 单位 mm, 返回本次新触发的事件
+  LD2413Event update(float distance, uint32_t now);
+  bool has_rate() const { return this->valid_; }
+  // 液位变化速率 mm/min, 正数为上涨(距离变小)
+  float get_rate() const { return this->rate_; }
+  void reset();
+
+ protected:
+  struct Sample {
+    float t;  // 相对 base_ 的秒数
+    float distance;
+  };
+  void push_(float t, float distance);
+  void pop_();
+  void rebase_();
+  LD2413Event classify_(uint32_t now);
+
+  uint32_t window_{300000};
+  float fill_rate_{0};  // 0 表示不检测
+  float drain_rate_{0};
+  float leak_rate_{0};
+  uint32_t leak_duration_{0};
+
+  std::array<Sample, LD2413_HISTORY_SIZE> history_{};
+  uint8_t head_{0};
+  uint8_t count_{0};
+  uint32_t base_{0};
+  // 回归用的累加和, 入队出队时增减
+  double sum_t_{0};
+  double sum_d_{0};
+  double sum_tt_{0};
+  double sum_td_{0};
+
+  bool valid_{false};
+  float rate_{0};
+  LD2413Event state_{LD2413_EVENT_NONE};
+  uint32_t leak_since_{0};
+  bool leak_reported_{false};
+};
+
+}  // namespace ld2413
+}  // namespace esphome
@@ -3,7 +3,8 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import automation
 from esphome.components import uart
-from esphome.const import CONF_ID, CONF_DIRECTION, CONF_BAUD_RATE
+from esphome.const import CONF_ID, CONF_DIRECTION, CONF_BAUD_RATE, CONF_PLATFORM, CONF_TARGET
+from esphome.core import CORE
 
 CODEOWNERS = ["@synodriver"]
 DEPENDENCIES = ["uart"]
@@ -16,6 +17,18 @@ CONF_MAX_DISTANCE = "max_distance"
 CONF_MIN_DISTANCE = "min_distance"
 CONF_MIN_SPEED = "min_speed"
 CONF_NO_TARGET_DELAY = "no_target_delay"
+CONF_TRACKING = "tracking"
+CONF_ANGLE_GATE = "angle_gate"
+CONF_DISTANCE_GATE = "distance_gate"
+CONF_SPEED_GATE = "speed_gate"
+CONF_ALPHA = "alpha"
+CONF_BETA = "beta"
+CONF_MAX_MISSED = "max_missed"
+CONF_CONFIRM_FRAMES = "confirm_frames"
+CONF_ANGLE_DEADBAND = "angle_deadband"
+CONF_DISTANCE_DEADBAND = "distance_deadband"
+CONF_SPEED_DEADBAND = "speed_deadband"
+CONF_STATISTICS_INTERVAL = "statistics_interval"
 
 ld2451 = cg.esphome_ns.namespace("ld2451")
 LD2451Component = ld2451.class_("LD2451Component", cg.Component, uart.UARTDevice)
@@ -51,12 +64,43 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_DIRECTION, default="both"): cv.enum(LD2451_DIRECTION_OPTIONS),
             cv.Optional(CONF_MIN_SPEED, default=0): cv.int_range(0x00, 0x78),
             cv.Optional(CONF_NO_TARGET_DELAY, default=1): cv.uint8_t,
+            # 逐帧关联目标, target_N 对应固定的轨迹, 只在出现, 消失和变化超过 deadband 时发布
+            cv.Optional(CONF_TRACKING): cv.Schema(
+                {
+                    cv.Optional(CONF_ANGLE_GATE, default=10): cv.positive_float,  # 度
+                    cv.Optional(CONF_DISTANCE_GATE, default=5): cv.positive_float,  # 米
+                    cv.Optional(CONF_SPEED_GATE, default=15): cv.positive_float,  # km/h
+                    cv.Optional(CONF_ALPHA, default=0.5): cv.float_range(min=0, max=1, min_included=False),
+                    cv.Optional(CONF_BETA, default=0.1): cv.float_range(min=0, max=1),
+                    cv.Optional(CONF_MAX_MISSED, default=3): cv.uint8_t,
+                    cv.Optional(CONF_CONFIRM_FRAMES, default=2): cv.int_range(1, 255),
+                    cv.Optional(CONF_ANGLE_DEADBAND, default=1): cv.positive_float,
+                    cv.Optional(CONF_DISTANCE_DEADBAND, default=0.5): cv.positive_float,
+                    cv.Optional(CONF_SPEED_DEADBAND, default=1): cv.positive_float,
+                }
+            ),
+            # 车流统计的窗口长度, 统计传感器每个窗口结束时发布一次
+            cv.Optional(CONF_STATISTICS_INTERVAL, default="60s"): cv.positive_time_period_milliseconds,
         }
     )
     .extend(cv.COMPONENT_SCHEMA)
     .extend(uart.UART_DEVICE_SCHEMA)
 )
 
+def target_slots():
+    """sensor / text_sensor 平台里用到的最大 target 序号, 决定 C++ 里每目标数组的长度"""
+    slots = 0
+    for domain in ("sensor", "text_sensor"):
+        for conf in CORE.config.get(domain, []):
+            if conf.get(CONF_PLATFORM) != "ld2451":
+                continue
+            for n in range(MAX_TARGETS):
+                if f"{CONF_TARGET}_{n + 1}" in conf:
+                    slots = max(slots, n + 1)
+    # 没配置 target 传感器时也保留一个槽位, 避免生成长度为 0 的数组
+    return max(slots, 1)
+
+
 FINAL_VALIDATE_SCHEMA = uart.final_validate_device_schema(
     "ld2451",
     require_tx=True,
@@ -70,6 +114,7 @@ async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
     await uart.register_uart_device(var, config)
+    cg.add_define("LD2451_TARGET_SLOTS", target_slots())
     cg.add(var.set_valid_trigs(config[CONF_VALID_TRIGS]))
     cg.add(var.set_signal_threshold(config[CONF_SIGNAL_THRESHOLD]))
 
@@ -77,6 +122,19 @@ async def to_code(config):
     cg.add(var.set_direction(config[CONF_DIRECTION]))
     cg.add(var.set_min_speed(config[CONF_MIN_SPEED]))
     cg.add(var.set_no_target_delay(config[CONF_NO_TARGET_DELAY]))
+    cg.add(var.set_statistics_interval(config[CONF_STATISTICS_INTERVAL]))
+    if tracking_config := config.get(CONF_TRACKING):
+        cg.add(var.set_tracking(True))
+        tracker = var.get_tracker()
+        cg.add(tracker.set_gates(tracking_config[CONF_ANGLE_GATE],
+                                 tracking_config[CONF_DISTANCE_GATE],
+                                 tracking_config[CONF_SPEED_GATE]))
+        cg.add(tracker.set_smoothing(tracking_config[CONF_ALPHA], tracking_config[CONF_BETA]))
+        cg.add(tracker.set_max_missed(tracking_config[CONF_MAX_MISSED]))
+        cg.add(tracker.set_confirm_frames(tracking_config[CONF_CONFIRM_FRAMES]))
+        cg.add(var.set_publish_deadbands(tracking_config[CONF_ANGLE_DEADBAND],
+                                         tracking_config[CONF_DISTANCE_DEADBAND],
+                                         tracking_config[CONF_SPEED_DEADBAND]))
 
 LD2451SetBaudRateAction = ld2451.class_("LD2451SetBaudRateAction", automation.Action)
 LD2451_SET_BAUD_RATE_ACTION_SCHEMA = automation.maybe_simple_id(
@@ -1,4 +1,6 @@
 #include "ld2451.h"
+#include <algorithm>
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -18,6 +20,7 @@ static const uint16_t GET_VERSION = 0x00A0;
 static const uint16_t SET_BAUD_RATE = 0x00A1;
 static const uint16_t RESET = 0x00A2;
 static const uint16_t RESTART = 0x00A3;
+static const uint32_t LD2451_STALE_TIMEOUT = 1000;
 
 void LD2451Component::setup() {
   ESP_LOGCONFIG(TAG, "Setting up LD2451...");
@@ -25,6 +28,10 @@ void LD2451Component::setup() {
   this->set_sensitivity(this->valid_trigs_, this->signal_threshold_);
   this->set_target_detect_config(this->max_distance_, this->direction_, this->min_speed_, this->delay_);
   this->disable_config();
+  if (this->statistics_) {
+    this->stats_.start(millis());
+    this->set_interval("statistics", this->statistics_interval_, [this]() { this->publish_statistics_(); });
+  }
 #ifdef USE_TEXT_SENSOR
   if (this->version_text_sensor_ != nullptr) {
     this->version_text_sensor_->publish_state(this->version());
@@ -42,7 +49,12 @@ void LD2451Component::dump_config() {
 #endif
 #ifdef USE_SENSOR
   LOG_SENSOR("  ", "Target Number", this->target_number_sensor_);
-  for (uint8_t i = 0; i < MAX_TARGETS; i++) {
+  LOG_SENSOR("  ", "Towards Count", this->towards_count_sensor_);
+  LOG_SENSOR("  ", "Away Count", this->away_count_sensor_);
+  LOG_SENSOR("  ", "Mean Speed", this->mean_speed_sensor_);
+  LOG_SENSOR("  ", "P85 Speed", this->p85_speed_sensor_);
+  LOG_SENSOR("  ", "Occupancy", this->occupancy_sensor_);
+  for (uint8_t i = 0; i < LD2451_TARGET_SLOTS; i++) {
     ESP_LOGCONFIG(TAG, "target %d:\n", i + 1);
     if (this->target_angle_sensors_[i] != nullptr) {
       LOG_SENSOR("  ", "Target Angle", this->target_angle_sensors_[i]);
@@ -56,19 +68,46 @@ void LD2451Component::dump_config() {
     if (this->target_signal_strength_sensors_[i] != nullptr) {
       LOG_SENSOR("  ", "Target Signal Strength", this->target_signal_strength_sensors_[i]);
     }
+    if (this->target_track_id_sensors_[i] != nullptr) {
+      LOG_SENSOR("  ", "Target Track Id", this->target_track_id_sensors_[i]);
+    }
   }
 #endif
 #ifdef USE_TEXT_SENSOR
-  for (uint8_t i = 0; i < MAX_TARGETS; i++) {
+  for (uint8_t i = 0; i < LD2451_TARGET_SLOTS; i++) {
     if (this->target_direction_text_sensors_[i] != nullptr) {
       LOG_TEXT_SENSOR("  ", "Target Direction", this->target_direction_text_sensors_[i]);
     }
   }
 #endif
+  if (this->statistics_) {
+    ESP_LOGCONFIG(TAG, "  Statistics Interval: %" PRIu32 " ms", this->statistics_interval_);
+  }
+  if (this->tracking_) {
+    ESP_LOGCONFIG(TAG, "  Tracking: deadband angle %.1f, distance %.1f, speed %.1f", this->angle_deadband_,
+                  this->distance_deadband_, this->speed_deadband_);
+  }
   this->check_uart_settings(115200);
 }
 
 void LD2451Component::loop() {
+  // 超过 1 秒没有数据帧, 认为所有目标都已离开
+  if (this->last_num_ > 0 && millis() - this->last_frame_time_ > LD2451_STALE_TIMEOUT) {
+    for (uint8_t i = 0; i < LD2451_TARGET_SLOTS; i++) {
+      if (this->published_[i].id != 0 || i < this->last_num_) {
+        this->clear_target_(i);
+      }
+      this->published_[i] = LD2451PublishedTarget{};
+    }
+    this->last_num_ = 0;
+    this->tracker_.reset();
+    this->stats_.flush_tracks();
+#ifdef USE_SENSOR
+    if (this->target_number_sensor_ != nullptr) {
+      this->target_number_sensor_->publish_state(0);
+    }
+#endif
+  }
   uint8_t peeked;
   while (this->available() && !this->in_config) {
     if (!this->head_found && this->peek_byte(&peeked) && peeked != 0xFD) {
@@ -101,56 +140,203 @@ void LD2451Component::loop() {
     this->head_found = false;
     return;
   }
-  uint8_t *ptr = this->receive_buffer.data() + 6;
+  this->handle_targets_(this->receive_buffer.data() + 6);
+  this->receive_buffer.erase(this->receive_buffer.begin(), this->receive_buffer.begin() + frame_size + 10);
+}
+
+void LD2451Component::handle_targets_(const uint8_t *ptr) {
   uint8_t num = ptr[0];  // 目标数量
+  if (num > MAX_TARGETS) {
+    ESP_LOGW(TAG, "Received target number %d exceeds maximum of %d", num, MAX_TARGETS);
+    num = MAX_TARGETS;
+  }
+  std::array<LD2451Detection, MAX_TARGETS> detections;
+  for (uint8_t i = 0; i < num; i++) {
+    const uint8_t *target = ptr + 2 + 5 * i;
+    detections[i].angle = ((int16_t) target[0]) - 0x80;
+    detections[i].distance = target[1];
+    detections[i].direction = target[2];
+    detections[i].speed = target[3];
+    detections[i].signal = target[4];  // 信噪比
+  }
+#ifdef USE_BINARY_SENSOR
+  if (this->has_towards_target_binary_sensor_ != nullptr && (!this->tracking_ || ptr[1] != this->last_towards_)) {
+    this->has_towards_target_binary_sensor_->publish_state(ptr[1] != 0);
+  }
+#endif
+  this->last_towards_ = ptr[1];
+  uint32_t now = millis();
+  this->last_frame_time_ = now;
+  if (this->tracking_ || this->statistics_) {
+    this->tracker_.update(detections.data(), num, now);
+  }
+  if (this->statistics_) {
+    this->stats_.update(this->tracker_.get_tracks(), now);
+  }
+  if (this->tracking_) {
+    this->publish_tracks_();
+  } else {
+    this->publish_raw_targets_(detections.data(), num);
+  }
+}
+
+void LD2451Component::publish_raw_targets_(const LD2451Detection *detections, uint8_t num) {
 #ifdef USE_SENSOR
   if (this->target_number_sensor_ != nullptr) {
     this->target_number_sensor_->publish_state(num);
   }
 #endif
-#ifdef USE_BINARY_SENSOR
-  if (this->has_towards_target_binary_sensor_ != nullptr) {
-    if (ptr[1]) {
-      this->has_towards_target_binary_sensor_->publish_state(true);
-    } else {
-      this->has_towards_target_binary_sensor_->publish_state(false);
-    }
-  }
-#endif
-  uint8_t angle, distance, direction, speed, signal;
-  for (uint8_t i = 0; i < num; i++) {
-    if (i >= MAX_TARGETS) {
-      ESP_LOGW(TAG, "Received target number %d exceeds maximum of %d", num, MAX_TARGETS);
-      break;
-    }
-    angle = ptr[2 + 5 * i];
-    distance = ptr[2 + 5 * i + 1];
-    direction = ptr[2 + 5 * i + 2];
-    speed = ptr[2 + 5 * i + 3];
-    signal = ptr[2 + 5 * i + 4];  // 信噪比 publish_state here
+  // 只有前 LD2451_TARGET_SLOTS 个目标配置了传感器
+  uint8_t slots = std::min<uint8_t>(num, LD2451_TARGET_SLOTS);
+  for (uint8_t i = 0; i < slots; i++) {
+    const LD2451Detection &det = detections[i];
 #ifdef USE_SENSOR
     if (this->target_angle_sensors_[i] != nullptr) {
-      this->target_angle_sensors_[i]->publish_state(((int16_t)angle)-0x80);
+      this->target_angle_sensors_[i]->publish_state(det.angle);
     }
     if (this->target_distance_sensors_[i] != nullptr) {
-      this->target_distance_sensors_[i]->publish_state(distance);
+      this->target_distance_sensors_[i]->publish_state(det.distance);
     }
 #endif
 #ifdef USE_TEXT_SENSOR
     if (this->target_direction_text_sensors_[i] != nullptr) {
-      this->target_direction_text_sensors_[i]->publish_state(direction ? "towards" : "away");
+      this->target_direction_text_sensors_[i]->publish_state(det.direction ? "towards" : "away");
     }
 #endif
 #ifdef USE_SENSOR
     if (this->target_speed_sensors_[i] != nullptr) {
-      this->target_speed_sensors_[i]->publish_state(speed);
+      this->target_speed_sensors_[i]->publish_state(det.speed);
     }
     if (this->target_signal_strength_sensors_[i] != nullptr) {
-      this->target_signal_strength_sensors_[i]->publish_state(signal);
+      this->target_signal_strength_sensors_[i]->publish_state(det.signal);
     }
 #endif
   }
-  this->receive_buffer.erase(this->receive_buffer.begin(), this->receive_buffer.begin() + frame_size + 10);
+  // 上一帧还在, 这一帧消失的目标置为未知
+  for (uint8_t i = slots; i < std::min<uint8_t>(this->last_num_, LD2451_TARGET_SLOTS); i++) {
+    this->clear_target_(i);
+  }
+  this->last_num_ = num;
+}
+
+void LD2451Component::publish_tracks_() {
+  const auto &tracks = this->tracker_.get_tracks();
+  uint8_t confirmed = 0;
+  for (uint8_t i = 0; i < MAX_TARGETS; i++) {
+    const LD2451Track &track = tracks[i];
+    if (i >= LD2451_TARGET_SLOTS) {
+      // 没有对应传感器的槽位只参与计数
+      confirmed += track.id != 0 && track.confirmed;
+      continue;
+    }
+    LD2451PublishedTarget &pub = this->published_[i];
+    if (track.id == 0 || !track.confirmed) {
+      if (pub.id != 0) {
+        this->clear_target_(i);  // 轨迹消失
+        pub = LD2451PublishedTarget{};
+      }
+      continue;
+    }
+    confirmed++;
+    bool born = pub.id != track.id;
+    if (born) {
+      pub = LD2451PublishedTarget{};
+      pub.id = track.id;
+#ifdef USE_SENSOR
+      if (this->target_track_id_sensors_[i] != nullptr) {
+        this->target_track_id_sensors_[i]->publish_state(track.id);
+      }
+#endif
+    }
+#ifdef USE_SENSOR
+    if (born || std::fabs(track.angle - pub.angle) >= this->angle_deadband_) {
+      pub.angle = track.angle;
+      if (this->target_angle_sensors_[i] != nullptr) {
+        this->target_angle_sensors_[i]->publish_state(track.angle);
+      }
+    }
+    if (born || std::fabs(track.distance - pub.distance) >= this->distance_deadband_) {
+      pub.distance = track.distance;
+      if (this->target_distance_sensors_[i] != nullptr) {
+        this->target_distance_sensors_[i]->publish_state(track.distance);
+      }
+    }
+    if (born || std::fabs(track.speed - pub.speed) >= this->speed_deadband_) {
+      pub.speed = track.speed;
+      if (this->target_speed_sensors_[i] != nullptr) {
+        this->target_speed_sensors_[i]->publish_state(track.speed);
+      }
+    }
+    if (born || track.signal != pub.signal) {
+      pub.signal = track.signal;
+      if (this->target_signal_strength_sensors_[i] != nullptr) {
+        this->target_signal_strength_sensors_[i]->publish_state(track.signal);
+      }
+    }
+#endif
+    if (born || track.direction != pub.direction) {
+      pub.direction = track.direction;
+#ifdef USE_TEXT_SENSOR
+      if (this->target_direction_text_sensors_[i] != nullptr) {
+        this->target_direction_text_sensors_[i]->publish_state(track.direction ? "towards" : "away");
+      }
+#endif
+    }
+  }
+#ifdef USE_SENSOR
+  if (this->target_number_sensor_ != nullptr && confirmed != this->last_num_) {
+    this->target_number_sensor_->publish_state(confirmed);
+  }
+#endif
+  this->last_num_ = confirmed;
+}
+
+void LD2451Component::publish_statistics_() {
+  LD2451TrafficWindow window = this->stats_.take_window(millis());
+  ESP_LOGD(TAG, "Traffic: towards %" PRIu32 ", away %" PRIu32 ", mean %.1f km/h, p85 %.1f km/h, occupancy %.1f%%",
+           window.towards_count, window.away_count, window.mean_speed, window.p85_speed, window.occupancy);
+#ifdef USE_SENSOR
+  if (this->towards_count_sensor_ != nullptr) {
+    this->towards_count_sensor_->publish_state(window.towards_count);
+  }
+  if (this->away_count_sensor_ != nullptr) {
+    this->away_count_sensor_->publish_state(window.away_count);
+  }
+  if (this->mean_speed_sensor_ != nullptr) {
+    this->mean_speed_sensor_->publish_state(window.mean_speed);
+  }
+  if (this->p85_speed_sensor_ != nullptr) {
+    this->p85_speed_sensor_->publish_state(window.p85_speed);
+  }
+  if (this->occupancy_sensor_ != nullptr) {
+    this->occupancy_sensor_->publish_state(window.occupancy);
+  }
+#endif
+}
+
+void LD2451Component::clear_target_(uint8_t i) {
+#ifdef USE_SENSOR
+  if (this->target_angle_sensors_[i] != nullptr) {
+    this->target_angle_sensors_[i]->publish_state(NAN);
+  }
+  if (this->target_distance_sensors_[i] != nullptr) {
+    this->target_distance_sensors_[i]->publish_state(NAN);
+  }
+  if (this->target_speed_sensors_[i] != nullptr) {
+    this->target_speed_sensors_[i]->publish_state(NAN);
+  }
+  if (this->target_signal_strength_sensors_[i] != nullptr) {
+    this->target_signal_strength_sensors_[i]->publish_state(NAN);
+  }
+  if (this->target_track_id_sensors_[i] != nullptr) {
+    this->target_track_id_sensors_[i]->publish_state(NAN);
+  }
+#endif
+#ifdef USE_TEXT_SENSOR
+  if (this->target_direction_text_sensors_[i] != nullptr) {
+    this->target_direction_text_sensors_[i]->publish_state("");
+  }
+#endif
 }
 
 bool LD2451Component::restart() {
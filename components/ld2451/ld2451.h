@@ -6,6 +6,8 @@
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
 #include "esphome/components/uart/uart.h"
+#include "tracker.h"
+#include "traffic_stats.h"
 #ifdef USE_SENSOR
 #include "esphome/components/sensor/sensor.h"
 #endif
@@ -19,7 +21,21 @@
 namespace esphome {
 namespace ld2451 {
 
-#define MAX_TARGETS 20
+// 由 __init__.py 按 yaml 里配置的最大 target 序号生成, 未生成时按协议上限
+#ifndef LD2451_TARGET_SLOTS
+#define LD2451_TARGET_SLOTS MAX_TARGETS
+#endif
+static_assert(LD2451_TARGET_SLOTS >= 1 && LD2451_TARGET_SLOTS <= MAX_TARGETS, "LD2451_TARGET_SLOTS out of range");
+
+// 每个 target 槽位上次发布的值, 用于只在变化时发布
+struct LD2451PublishedTarget {
+  uint16_t id{0};
+  float angle{NAN};
+  float distance{NAN};
+  float speed{NAN};
+  uint8_t direction{0xFF};
+  uint8_t signal{0};
+};
 
 enum LD2451_DIRECTION : uint8_t {
   LD2451_DIRECTION_AWAY = 0x00,     // Object is moving away from the sensor
@@ -41,6 +57,11 @@ enum LD2451_BAUD_RATE : uint16_t {
 class LD2451Component : public Component, public uart::UARTDevice {
 #ifdef USE_SENSOR
   SUB_SENSOR(target_number)
+  SUB_SENSOR(towards_count)
+  SUB_SENSOR(away_count)
+  SUB_SENSOR(mean_speed)
+  SUB_SENSOR(p85_speed)
+  SUB_SENSOR(occupancy)
 #endif
 
 #ifdef USE_BINARY_SENSOR
@@ -62,6 +83,15 @@ class LD2451Component : public Component, public uart::UARTDevice {
   void set_direction(LD2451_DIRECTION direction) { this->direction_ = direction; }
   void set_min_speed(uint8_t min_speed) { this->min_speed_ = min_speed; }
   void set_no_target_delay(uint8_t d) {this->delay_ = d; }
+  void set_tracking(bool tracking) { this->tracking_ = tracking; }
+  void set_statistics(bool statistics) { this->statistics_ = statistics; }
+  void set_statistics_interval(uint32_t interval) { this->statistics_interval_ = interval; }
+  LD2451Tracker &get_tracker() { return this->tracker_; }
+  void set_publish_deadbands(float angle, float distance, float speed) {
+    this->angle_deadband_ = angle;
+    this->distance_deadband_ = distance;
+    this->speed_deadband_ = speed;
+  }
 
 
   void disable_config();
@@ -79,6 +109,7 @@ class LD2451Component : public Component, public uart::UARTDevice {
   void set_target_distance_sensor(uint8_t target, sensor::Sensor *s) { this->target_distance_sensors_[target] = s;}
   void set_target_speed_sensor(uint8_t target, sensor::Sensor *s) { this->target_speed_sensors_[target] = s; }
   void set_target_signal_strength_sensor(uint8_t target, sensor::Sensor *s) { this->target_signal_strength_sensors_[target] = s; }
+  void set_target_track_id_sensor(uint8_t target, sensor::Sensor *s) { this->target_track_id_sensors_[target] = s; }
 #endif
 #ifdef USE_TEXT_SENSOR
   void set_target_direction_text_sensor(uint8_t target, text_sensor::TextSensor *s) {
@@ -93,16 +124,35 @@ class LD2451Component : public Component, public uart::UARTDevice {
   uint8_t min_speed_;
   uint8_t delay_;
 #ifdef USE_SENSOR
-  std::array<sensor::Sensor *, MAX_TARGETS> target_angle_sensors_{};
-  std::array<sensor::Sensor *, MAX_TARGETS> target_distance_sensors_{};
-  std::array<sensor::Sensor *, MAX_TARGETS> target_speed_sensors_{};
-  std::array<sensor::Sensor *, MAX_TARGETS> target_signal_strength_sensors_{};
+  std::array<sensor::Sensor *, LD2451_TARGET_SLOTS> target_angle_sensors_{};
+  std::array<sensor::Sensor *, LD2451_TARGET_SLOTS> target_distance_sensors_{};
+  std::array<sensor::Sensor *, LD2451_TARGET_SLOTS> target_speed_sensors_{};
+  std::array<sensor::Sensor *, LD2451_TARGET_SLOTS> target_signal_strength_sensors_{};
+  std::array<sensor::Sensor *, LD2451_TARGET_SLOTS> target_track_id_sensors_{};
 #endif
 
 #ifdef USE_TEXT_SENSOR
   text_sensor::TextSensor *version_text_sensor_;
-  std::array<text_sensor::TextSensor *, MAX_TARGETS> target_direction_text_sensors_{};
+  std::array<text_sensor::TextSensor *, LD2451_TARGET_SLOTS> target_direction_text_sensors_{};
 #endif
+  bool tracking_{false};
+  LD2451Tracker tracker_;
+  float angle_deadband_{1.0f};
+  float distance_deadband_{0.5f};
+  float speed_deadband_{1.0f};
+  std::array<LD2451PublishedTarget, LD2451_TARGET_SLOTS> published_{};
+  bool statistics_{false};
+  uint32_t statistics_interval_{60000};
+  LD2451TrafficStats stats_;
+  void publish_statistics_();
+  uint8_t last_num_{0};
+  uint8_t last_towards_{0xFF};
+  uint32_t last_frame_time_{0};
+  void handle_targets_(const uint8_t *ptr);
+  void publish_raw_targets_(const LD2451Detection *detections, uint8_t num);
+  void publish_tracks_();
+  void clear_target_(uint8_t i);
+
   bool in_config{false};
   bool head_found{false};
   void send_command(uint16_t command, const uint8_t *data, size_t data_size, uint16_t *ret_command, std::string *value);
@@ -1,6 +1,7 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.const import UNIT_METER, CONF_SPEED, UNIT_KILOMETER_PER_HOUR, ICON_SIGNAL, STATE_CLASS_MEASUREMENT
+from esphome.const import UNIT_METER, CONF_SPEED, UNIT_KILOMETER_PER_HOUR, ICON_SIGNAL, STATE_CLASS_MEASUREMENT, \
+    UNIT_PERCENT
 from esphome.components import sensor
 from esphome.const import (
     CONF_TARGET,
@@ -14,6 +15,16 @@ ICON_MAP_MARKER_DISTANCE = "mdi:map-marker-distance"
 ICON_SPEED = "mdi:speedometer"
 ICON_CAR = "mdi:car-convertible"
 CONF_TARGET_NUMBER = "target_number"
+CONF_TRACK_ID = "track_id"
+CONF_TOWARDS_COUNT = "towards_count"
+CONF_AWAY_COUNT = "away_count"
+CONF_MEAN_SPEED = "mean_speed"
+CONF_P85_SPEED = "p85_speed"
+CONF_OCCUPANCY = "occupancy"
+ICON_TIMER_SAND = "mdi:timer-sand"
+
+# 车流统计, 按 statistics_interval 窗口发布
+STATISTICS_SENSORS = [CONF_TOWARDS_COUNT, CONF_AWAY_COUNT, CONF_MEAN_SPEED, CONF_P85_SPEED, CONF_OCCUPANCY]
 
 DEPENDENCIES = ["ld2451"]
 
@@ -26,59 +37,59 @@ CONFIG_SCHEMA = cv.All(
                 accuracy_decimals=0,
                 state_class=STATE_CLASS_MEASUREMENT,
                 unit_of_measurement="#",
-                filters=[
-                    {
-                        "timeout": {
-                            "timeout": cv.TimePeriod(milliseconds=1000),
-                        }
-                    },
-                ],
-            )
+            ),
+            cv.Optional(CONF_TOWARDS_COUNT): sensor.sensor_schema(
+                icon=ICON_CAR,
+                accuracy_decimals=0,
+                state_class=STATE_CLASS_MEASUREMENT,
+                unit_of_measurement="#",
+            ),
+            cv.Optional(CONF_AWAY_COUNT): sensor.sensor_schema(
+                icon=ICON_CAR,
+                accuracy_decimals=0,
+                state_class=STATE_CLASS_MEASUREMENT,
+                unit_of_measurement="#",
+            ),
+            cv.Optional(CONF_MEAN_SPEED): sensor.sensor_schema(
+                device_class=DEVICE_CLASS_SPEED,
+                unit_of_measurement=UNIT_KILOMETER_PER_HOUR,
+                icon=ICON_SPEED,
+                accuracy_decimals=1,
+                state_class=STATE_CLASS_MEASUREMENT,
+            ),
+            # 85 分位车速
+            cv.Optional(CONF_P85_SPEED): sensor.sensor_schema(
+                device_class=DEVICE_CLASS_SPEED,
+                unit_of_measurement=UNIT_KILOMETER_PER_HOUR,
+                icon=ICON_SPEED,
+                accuracy_decimals=1,
+                state_class=STATE_CLASS_MEASUREMENT,
+            ),
+            # 窗口内有确认轨迹的时间占比
+            cv.Optional(CONF_OCCUPANCY): sensor.sensor_schema(
+                unit_of_measurement=UNIT_PERCENT,
+                icon=ICON_TIMER_SAND,
+                accuracy_decimals=1,
+                state_class=STATE_CLASS_MEASUREMENT,
+            ),
         }
     )
     .extend(
         {
             cv.Optional(f"{CONF_TARGET}_{n + 1}"): cv.Schema({
                 cv.Optional(CONF_ANGLE): sensor.sensor_schema(unit_of_measurement=UNIT_DEGREES,
-                                                              icon=ICON_FORMAT_TEXT_ROTATION_ANGLE_UP,
-                                                              filters=[
-                                                                  {
-                                                                      "timeout": {
-                                                                          "timeout": cv.TimePeriod(milliseconds=1000),
-                                                                      }
-                                                                  },
-                                                              ], ),
+                                                              icon=ICON_FORMAT_TEXT_ROTATION_ANGLE_UP),
                 cv.Optional(CONF_DISTANCE): sensor.sensor_schema(device_class=DEVICE_CLASS_DISTANCE,
                                                                  unit_of_measurement=UNIT_METER,
-                                                                 icon=ICON_MAP_MARKER_DISTANCE,
-                                                                 filters=[
-                                                                     {
-                                                                         "timeout": {
-                                                                             "timeout": cv.TimePeriod(
-                                                                                 milliseconds=1000),
-                                                                         }
-                                                                     },
-                                                                 ], ),
+                                                                 icon=ICON_MAP_MARKER_DISTANCE),
                 cv.Optional(CONF_SPEED): sensor.sensor_schema(device_class=DEVICE_CLASS_SPEED,
                                                               unit_of_measurement=UNIT_KILOMETER_PER_HOUR,
-                                                              icon=ICON_SPEED,
-                                                              filters=[
-                                                                  {
-                                                                      "timeout": {
-                                                                          "timeout": cv.TimePeriod(milliseconds=1000),
-                                                                      }
-                                                                  },
-                                                              ], ),
+                                                              icon=ICON_SPEED),
                 cv.Optional(CONF_SIGNAL_STRENGTH): sensor.sensor_schema(unit_of_measurement="#",
-                                                                        icon=ICON_SIGNAL,
-                                                                        filters=[
-                                                                            {
-                                                                                "timeout": {
-                                                                                    "timeout": cv.TimePeriod(
-                                                                                        milliseconds=1000),
-                                                                                }
-                                                                            },
-                                                                        ], )  # 信噪比
+                                                                        icon=ICON_SIGNAL),  # 信噪比
+                # 开启 tracking 时该槽位当前轨迹的编号
+                cv.Optional(CONF_TRACK_ID): sensor.sensor_schema(icon=ICON_CAR,
+                                                                 accuracy_decimals=0),
 
             }) for n in range(MAX_TARGETS)
         }
@@ -91,6 +102,11 @@ async def to_code(config):
     if target_number_config := config.get(CONF_TARGET_NUMBER):
         sens = await sensor.new_sensor(target_number_config)
         cg.add(ld2451_component.set_target_number_sensor(sens))
+    for key in STATISTICS_SENSORS:
+        if stats_conf := config.get(key):
+            sens = await sensor.new_sensor(stats_conf)
+            cg.add(getattr(ld2451_component, f"set_{key}_sensor")(sens))
+            cg.add(ld2451_component.set_statistics(True))
     for n in range(MAX_TARGETS):
         if target_conf := config.get(f"{CONF_TARGET}_{n + 1}"):
             if angle_conf := target_conf.get(CONF_ANGLE):
@@ -109,3 +125,6 @@ async def to_code(config):
                 sens = await sensor.new_sensor(signal_strength_conf)
                 cg.add(ld2451_component.set_target_signal_strength_sensor(n, sens))
                 # cg.add(getattr(ld2451_component, f"set_target{n + 1}_signal_strength_sensor")(sens))
+            if track_id_conf := target_conf.get(CONF_TRACK_ID):
+                sens = await sensor.new_sensor(track_id_conf)
+                cg.add(ld2451_component.set_target_track_id_sensor(n, sens))
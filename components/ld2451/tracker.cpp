@@ -0,0 +1,128 @@
+#include "tracker.h"
+
+namespace esphome {
+namespace ld2451 {
+
+void LD2451Tracker::update(const LD2451Detection *detections, uint8_t count, uint32_t now) {
+  float dt = this->last_update_ == 0 ? 0.0f : (now - this->last_update_) / 1000.0f;
+  this->last_update_ = now;
+  if (count > MAX_TARGETS) {
+    count = MAX_TARGETS;
+  }
+
+  // 先算出代价矩阵, 之后按代价从小到大贪心匹配
+  auto &costs = this->costs_;
+  for (uint8_t t = 0; t < MAX_TARGETS; t++) {
+    for (uint8_t d = 0; d < count; d++) {
+      costs[t * MAX_TARGETS + d] = this->tracks_[t].id == 0 ? INFINITY : this->cost_(this->tracks_[t], detections[d], dt);
+    }
+  }
+  std::array<int8_t, MAX_TARGETS> track_det;
+  std::array<bool, MAX_TARGETS> det_used{};
+  track_det.fill(-1);
+  while (true) {
+    float best = INFINITY;
+    int8_t best_t = -1;
+    int8_t best_d = -1;
+    for (uint8_t t = 0; t < MAX_TARGETS; t++) {
+      if (track_det[t] >= 0) {
+        continue;
+      }
+      for (uint8_t d = 0; d < count; d++) {
+        if (!det_used[d] && costs[t * MAX_TARGETS + d] < best) {
+          best = costs[t * MAX_TARGETS + d];
+          best_t = t;
+          best_d = d;
+        }
+      }
+    }
+    if (best_t < 0) {
+      break;
+    }
+    track_det[best_t] = best_d;
+    det_used[best_d] = true;
+  }
+
+  for (uint8_t t = 0; t < MAX_TARGETS; t++) {
+    LD2451Track &track = this->tracks_[t];
+    if (track.id == 0) {
+      continue;
+    }
+    float pred_distance = track.distance + track.distance_rate * dt;
+    float pred_angle = track.angle + track.angle_rate * dt;
+    if (track_det[t] < 0) {
+      // 漏检时按预测值滑行, 超过 max_missed 帧则删除
+      if (++track.missed > this->max_missed_) {
+        track = LD2451Track{};
+        continue;
+      }
+      track.distance = pred_distance;
+      track.angle = pred_angle;
+      continue;
+    }
+    // alpha-beta 滤波
+    const LD2451Detection &det = detections[track_det[t]];
+    float residual_distance = det.distance - pred_distance;
+    float residual_angle = det.angle - pred_angle;
+    track.distance = pred_distance + this->alpha_ * residual_distance;
+    track.angle = pred_angle + this->alpha_ * residual_angle;
+    if (dt > 0) {
+      track.distance_rate += this->beta_ * residual_distance / dt;
+      track.angle_rate += this->beta_ * residual_angle / dt;
+    }
+    track.speed += this->alpha_ * (det.speed - track.speed);
+    track.direction = det.direction;
+    track.signal = det.signal;
+    track.missed = 0;
+    if (track.hits < 0xFF) {
+      track.hits++;
+    }
+    if (track.hits >= this->confirm_frames_) {
+      track.confirmed = true;
+    }
+  }
+
+  // 没匹配上的检测新建轨迹
+  for (uint8_t d = 0; d < count; d++) {
+    if (det_used[d]) {
+      continue;
+    }
+    for (auto &track : this->tracks_) {
+      if (track.id == 0) {
+        this->birth_(track, detections[d]);
+        break;
+      }
+    }
+  }
+}
+
+float LD2451Tracker::cost_(const LD2451Track &track, const LD2451Detection &det, float dt) const {
+  float da = std::fabs(det.angle - (track.angle + track.angle_rate * dt));
+  float dd = std::fabs(det.distance - (track.distance + track.distance_rate * dt));
+  float ds = std::fabs(det.speed - track.speed);
+  if (da > this->angle_gate_ || dd > this->distance_gate_ || ds > this->speed_gate_ || det.direction != track.direction) {
+    return INFINITY;
+  }
+  da /= this->angle_gate_;
+  dd /= this->distance_gate_;
+  ds /= this->speed_gate_;
+  return da * da + dd * dd + ds * ds;
+}
+
+void LD2451Tracker::birth_(LD2451Track &track, const LD2451Detection &det) {
+  track = LD2451Track{};
+  track.id = this->next_id_++;
+  if (this->next_id_ == 0) {
+    this->next_id_ = 1;
+  }
+  track.angle = det.angle;
+  track.distance = det.distance;
+  track.speed = det.speed;
+  track.direction = det.direction;
+  track.signal = det.signal;
+  track.hits = 1;
+  track.confirmed = track.hits >= this->confirm_frames_;
+}
+
+}  // namespace ld2451
+}  // namespace esphome
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cmath>
+
+namespace esphome {
+namespace ld2451 {
+
+static constexpr uint8_t MAX_TARGETS = 20;
+
+struct LD2451Detection {
+  float angle;     // 度
+  float distance;  // 米
+  float speed;     // km/h
+  uint8_t direction;
+  uint8_t signal;
+};
+
+struct LD2451Track {
+  uint16_t id{0};  // 0 表示空闲
+  float angle{0};
+  float angle_rate{0};  // 度/秒
+  float distance{0};
+  float distance_rate{0};  // 米/秒
+  float speed{0};
+  uint8_t direction{0};
+  uint8_t signal{0};
+  uint8_t hits{0};
+  uint8_t missed{0};
+  bool confirmed{false};
+};
+
+// 逐帧关联检测结果, 每条轨迹固定占用一个槽位, 槽位号即对外的 target 序号
+class LD2451Tracker {
+ public:
+  void set_gates(float angle, float distance, float speed) {
+    this->angle_gate_ = angle;
+    this->distance_gate_ = distance;
+    this->speed_gate_ = speed;
+  }
+  void set_smoothing(float alpha, float beta) {
+    this->alpha_ = alpha;
+    this->beta_ = beta;
+  }
+  void set_max_missed(uint8_t max_missed) { this->max_missed_ = max_missed; }
+  void set_confirm_frames(uint8_t confirm_frames) { this->confirm_frames_ = confirm_frames; }
+
+  void update(const LD2451Detection *detections, uint8_t count, uint32_t now);
+  void reset() {
+    this->tracks_.fill(LD2451Track{});
+    this->last_update_ = 0;
+  }
+  const std::array<LD2451Track, MAX_TARGETS> &get_tracks() const { return this->tracks_; }
+
+ protected:
+  float cost_(const LD2451Track &track, const LD2451Detection &det, float dt) const;
+  void birth_(LD2451Track &track, const LD2451Detection &det);
+
+  float angle_gate_{10};
+  float distance_gate_{5};
+  float speed_gate_{15};
+  float alpha_{0.5f};
+  float beta_{0.1f};
+  uint8_t max_missed_{3};
+  uint8_t confirm_frames_{2};
+
+  std::array<LD2451Track, MAX_TARGETS> tracks_{};
+  // 门限内的 (轨迹, 检测) 代价矩阵, 放在成员里免得 loop() 的栈上占 1.6 KB
+  std::array<float, MAX_TARGETS * MAX_TARGETS> costs_;
+  uint16_t next_id_{1};
+  uint32_t last_update_{0};
+};
+
+}  // namespace ld2451
+}  // namespace esphome
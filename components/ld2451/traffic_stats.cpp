@@ -0,0 +1,158 @@
+#include "traffic_stats.h"
+#include <algorithm>
+#include <cmath>
+
+namespace esphome {
+namespace ld2451 {
+
+void P2Quantile::add(float x) {
+  if (this->count_ < 5) {
+    this->q_[this->count_++] = x;
+    if (this->count_ == 5) {
+      std::sort(this->q_, this->q_ + 5);
+      for (int i = 0; i < 5; i++) {
+        this->n_[i] = i + 1;
+      }
+      this->np_[0] = 1;
+      this->np_[1] = 1 + 2 * this->p_;
+      this->np_[2] = 1 + 4 * this->p_;
+      this->np_[3] = 3 + 2 * this->p_;
+      this->np_[4] = 5;
+    }
+    return;
+  }
+  int k;
+  if (x < this->q_[0]) {
+    this->q_[0] = x;
+    k = 0;
+  } else if (x < this->q_[1]) {
+    k = 0;
+  } else if (x < this->q_[2]) {
+    k = 1;
+  } else if (x < this->q_[3]) {
+    k = 2;
+  } else if (x <= this->q_[4]) {
+    k = 3;
+  } else {
+    this->q_[4] = x;
+    k = 3;
+  }
+  for (int i = k + 1; i < 5; i++) {
+    this->n_[i] += 1;
+  }
+  const float dn[5] = {0, this->p_ / 2, this->p_, (1 + this->p_) / 2, 1};
+  for (int i = 0; i < 5; i++) {
+    this->np_[i] += dn[i];
+  }
+  // 调整中间三个标记点
+  for (int i = 1; i < 4; i++) {
+    float d = this->np_[i] - this->n_[i];
+    if ((d >= 1 && this->n_[i + 1] - this->n_[i] > 1) || (d <= -1 && this->n_[i - 1] - this->n_[i] < -1)) {
+      int ds = d > 0 ? 1 : -1;
+      float q = this->parabolic_(i, ds);
+      if (this->q_[i - 1] < q && q < this->q_[i + 1]) {
+        this->q_[i] = q;
+      } else {
+        this->q_[i] = this->linear_(i, ds);
+      }
+      this->n_[i] += ds;
+    }
+  }
+  this->count_++;
+}
+
+float P2Quantile::parabolic_(int i, int d) const {
+  return this->q_[i] + d / (this->n_[i + 1] - this->n_[i - 1]) *
+                           ((this->n_[i] - this->n_[i - 1] + d) * (this->q_[i + 1] - this->q_[i]) /
+                                (this->n_[i + 1] - this->n_[i]) +
+                            (this->n_[i + 1] - this->n_[i] - d) * (this->q_[i] - this->q_[i - 1]) /
+                                (this->n_[i] - this->n_[i - 1]));
+}
+
+float P2Quantile::linear_(int i, int d) const {
+  return this->q_[i] + d * (this->q_[i + d] - this->q_[i]) / (this->n_[i + d] - this->n_[i]);
+}
+
+float P2Quantile::value() const {
+  if (this->count_ == 0) {
+    return NAN;
+  }
+  if (this->count_ < 5) {
+    // 样本太少, 直接排序取值
+    float sorted[5];
+    std::copy(this->q_, this->q_ + this->count_, sorted);
+    std::sort(sorted, sorted + this->count_);
+    return sorted[(uint32_t) std::lround(this->p_ * (this->count_ - 1))];
+  }
+  return this->q_[2];
+}
+
+void LD2451TrafficStats::update(const std::array<LD2451Track, MAX_TARGETS> &tracks, uint32_t now) {
+  bool occupied = false;
+  for (uint8_t i = 0; i < MAX_TARGETS; i++) {
+    const LD2451Track &track = tracks[i];
+    Slot &slot = this->slots_[i];
+    if (track.id != slot.id) {
+      this->finish_(slot);
+      slot.id = track.id;
+    }
+    if (track.id != 0 && track.confirmed) {
+      slot.direction = track.direction;
+      slot.speed_sum += track.speed;
+      slot.samples++;
+      occupied = true;
+    }
+  }
+  if (this->occupied_ && this->last_update_ != 0) {
+    this->occupied_ms_ += now - this->last_update_;
+  }
+  this->occupied_ = occupied;
+  this->last_update_ = now;
+}
+
+void LD2451TrafficStats::flush_tracks() {
+  for (auto &slot : this->slots_) {
+    this->finish_(slot);
+  }
+  this->occupied_ = false;
+}
+
+void LD2451TrafficStats::finish_(Slot &slot) {
+  if (slot.samples > 0) {
+    if (slot.direction) {
+      this->towards_count_++;
+    } else {
+      this->away_count_++;
+    }
+    float speed = slot.speed_sum / slot.samples;
+    this->speed_sum_ += speed;
+    this->p85_.add(speed);
+  }
+  slot = Slot{};
+}
+
+LD2451TrafficWindow LD2451TrafficStats::take_window(uint32_t now) {
+  if (this->occupied_ && this->last_update_ != 0) {
+    this->occupied_ms_ += now - this->last_update_;
+    this->last_update_ = now;
+  }
+  LD2451TrafficWindow window;
+  window.towards_count = this->towards_count_;
+  window.away_count = this->away_count_;
+  uint32_t vehicles = this->towards_count_ + this->away_count_;
+  window.mean_speed = vehicles > 0 ? this->speed_sum_ / vehicles : NAN;
+  window.p85_speed = this->p85_.value();
+  uint32_t span = now - this->window_start_;
+  window.occupancy = span > 0 ? 100.0f * this->occupied_ms_ / span : NAN;
+
+  this->towards_count_ = 0;
+  this->away_count_ = 0;
+  this->speed_sum_ = 0;
+  this->p85_.reset();
+  this->occupied_ms_ = 0;
+  this->window_start_ = now;
+  return window;
+}
+
+}  // namespace ld2451
+}  // namespace esphome
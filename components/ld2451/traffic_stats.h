@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "tracker.h"
+
+namespace esphome {
+namespace ld2451 {
+
+// P² 算法估计分位数, 只保存 5 个标记点
+class P2Quantile {
+ public:
+  explicit P2Quantile(float p) : p_(p) {}
+  void reset() { this->count_ = 0; }
+  void add(float x);
+  uint32_t count() const { return this->count_; }
+  float value() const;
+
+ protected:
+  float parabolic_(int i, int d) const;
+  float linear_(int i, int d) const;
+
+  float p_;
+  uint32_t count_{0};
+  float q_[5];    // 标记点高度
+  float n_[5];    // 标记点实际位置
+  float np_[5];   // 标记点期望位置
+};
+
+struct LD2451TrafficWindow {
+  uint32_t towards_count;
+  uint32_t away_count;
+  float mean_speed;  // 没有车辆时为 NAN
+  float p85_speed;
+  float occupancy;  // 百分比
+};
+
+// 统计窗口内的车流: 每条轨迹结束时计一辆车, 车速取轨迹平均速度
+class LD2451TrafficStats {
+ public:
+  void start(uint32_t now) { this->window_start_ = now; }
+  void update(const std::array<LD2451Track, MAX_TARGETS> &tracks, uint32_t now);
+  // 所有轨迹都已结束(超时或重置)
+  void flush_tracks();
+  LD2451TrafficWindow take_window(uint32_t now);
+
+ protected:
+  struct Slot {
+    uint16_t id{0};
+    uint8_t direction{0};
+    float speed_sum{0};
+    uint32_t samples{0};
+  };
+  void finish_(Slot &slot);
+
+  std::array<Slot, MAX_TARGETS> slots_{};
+  P2Quantile p85_{0.85f};
+  uint32_t towards_count_{0};
+  uint32_t away_count_{0};
+  float speed_sum_{0};
+  uint32_t occupied_ms_{0};
+  uint32_t window_start_{0};
+  uint32_t last_update_{0};
+  bool occupied_{false};
+};
+
+}  // namespace ld2451
+}  // namespace esphome
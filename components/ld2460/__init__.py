@@ -6,8 +6,10 @@ from esphome.const import (
     CONF_ID,
     CONF_ANGLE,
     CONF_SENSITIVITY,
-    CONF_HEIGHT, CONF_MODE, CONF_ON_DATA, CONF_TRIGGER_ID
+    CONF_HEIGHT, CONF_MODE, CONF_ON_DATA, CONF_TRIGGER_ID, CONF_PLATFORM,
+    PLATFORM_ESP8266, PLATFORM_RP2040
 )
+from esphome.core import CORE
 
 CODEOWNERS = ["@synodriver"]
 DEPENDENCIES = ["uart"]
@@ -26,6 +28,107 @@ CONF_DETECT_END_ANGLE = "detect_end_angle"
 CONF_UPLOAD = "upload"
 
 LD2460DataTrigger = ld2460_ns.class_("LD2460DataTrigger", automation.Trigger.template())
+LD2460Zone = ld2460_ns.class_("LD2460Zone")
+LD2460HeatmapTrigger = ld2460_ns.class_(
+    "LD2460HeatmapTrigger", automation.Trigger.template(cg.std_vector.template(cg.uint8))
+)
+
+CONF_ZONES = "zones"
+CONF_ZONE_ID = "zone_id"
+CONF_POLYGON = "polygon"
+CONF_RECTANGLE = "rectangle"
+CONF_X_MIN = "x_min"
+CONF_X_MAX = "x_max"
+CONF_Y_MIN = "y_min"
+CONF_Y_MAX = "y_max"
+CONF_MARGIN = "margin"
+CONF_ENTRY_DELAY = "entry_delay"
+CONF_EXIT_DELAY = "exit_delay"
+CONF_HEATMAP = "heatmap"
+CONF_CELL_SIZE = "cell_size"
+CONF_RANGE = "range"
+CONF_SAMPLE_INTERVAL = "sample_interval"
+CONF_SAVE_INTERVAL = "save_interval"
+CONF_ON_EXPORT = "on_export"
+HEATMAP_MAX_CELLS = 4096
+HEATMAP_BLOCK_CELLS = 64
+# 持久化时每 64 格一个 128 字节的 preference, 这两个平台的 flash preference 一共只有 512 字节
+HEATMAP_PERSIST_MAX_CELLS = {
+    PLATFORM_ESP8266: HEATMAP_BLOCK_CELLS,
+    PLATFORM_RP2040: HEATMAP_BLOCK_CELLS,
+}
+CONF_TRACKING = "tracking"
+CONF_GATE = "gate"
+CONF_PROCESS_NOISE = "process_noise"
+CONF_MEASUREMENT_NOISE = "measurement_noise"
+CONF_MAX_MISSED = "max_missed"
+CONF_CONFIRM_FRAMES = "confirm_frames"
+CONF_POSITION_DEADBAND = "position_deadband"
+CONF_SPEED_DEADBAND = "speed_deadband"
+
+POINT_SCHEMA = cv.All(cv.ensure_list(cv.float_), cv.Length(min=2, max=2))  # [x, y], 米
+
+ZONE_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.Required(CONF_ID): cv.declare_id(LD2460Zone),
+            cv.Optional(CONF_POLYGON): cv.All(cv.ensure_list(POINT_SCHEMA), cv.Length(min=3)),
+            cv.Optional(CONF_RECTANGLE): cv.Schema(
+                {
+                    cv.Required(CONF_X_MIN): cv.float_,
+                    cv.Required(CONF_X_MAX): cv.float_,
+                    cv.Required(CONF_Y_MIN): cv.float_,
+                    cv.Required(CONF_Y_MAX): cv.float_,
+                }
+            ),
+            # 区域已占用时, 目标要离开边界超过 margin 才算离开, 避免在边界上来回跳
+            cv.Optional(CONF_MARGIN, default=0.2): cv.positive_float,
+            cv.Optional(CONF_ENTRY_DELAY, default="300ms"): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_EXIT_DELAY, default="3s"): cv.positive_time_period_milliseconds,
+        }
+    ),
+    cv.has_exactly_one_key(CONF_POLYGON, CONF_RECTANGLE),
+)
+
+
+def heatmap_grid(config):
+    """返回热力图网格的 (y_min, width, height)"""
+    heatmap_config = config[CONF_HEATMAP]
+    cell_size = heatmap_config[CONF_CELL_SIZE]
+    grid_range = heatmap_config[CONF_RANGE]
+    y_min = 0 if config[CONF_MODE] == "Side" else -grid_range
+    width = int(2 * grid_range / cell_size + 0.999)
+    height = int((grid_range - y_min) / cell_size + 0.999)
+    return y_min, width, height
+
+
+def validate_heatmap(config):
+    if CONF_HEATMAP in config:
+        _, width, height = heatmap_grid(config)
+        if width > 255 or height > 255 or width * height > HEATMAP_MAX_CELLS:
+            raise cv.Invalid(f"heatmap grid {width}x{height} too large, increase {CONF_CELL_SIZE} or reduce {CONF_RANGE}",
+                             path=[CONF_HEATMAP])
+    return config
+
+
+# 停留时间热力图, 侧装时 y 从 0 到 range, 顶装时 y 从 -range 到 range
+HEATMAP_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_CELL_SIZE, default=0.25): cv.float_range(min=0.05, max=2.55),
+        cv.Optional(CONF_RANGE, default=6): cv.float_range(min=0.5, max=20),
+        cv.Optional(CONF_SAMPLE_INTERVAL, default="1s"): cv.positive_time_period_milliseconds,
+        # 写 flash 的间隔, 不配置则不保存; 只有数据变化时才会写
+        cv.Optional(CONF_SAVE_INTERVAL): cv.All(
+            cv.positive_time_period_milliseconds,
+            cv.Range(min=cv.TimePeriod(minutes=10)),
+        ),
+        cv.Optional(CONF_ON_EXPORT): automation.validate_automation(
+            {
+                cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(LD2460HeatmapTrigger),
+            }
+        ),
+    }
+)
 
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
@@ -38,6 +141,21 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_DETECT_START_ANGLE, default=-45): cv.float_,
             cv.Optional(CONF_DETECT_END_ANGLE, default=-45): cv.float_,
             cv.Optional(CONF_SENSITIVITY, default="High"): cv.string,
+            cv.Optional(CONF_ZONES): cv.ensure_list(ZONE_SCHEMA),
+            cv.Optional(CONF_HEATMAP): HEATMAP_SCHEMA,
+            # 卡尔曼滤波平滑目标坐标, target_N 对应固定的轨迹, 漏检 max_missed 帧内按预测值保持
+            cv.Optional(CONF_TRACKING): cv.Schema(
+                {
+                    cv.Optional(CONF_GATE, default=1.0): cv.positive_float,  # 米
+                    cv.Optional(CONF_PROCESS_NOISE, default=1.0): cv.positive_float,  # 米/秒^2
+                    cv.Optional(CONF_MEASUREMENT_NOISE, default=0.15): cv.positive_float,  # 米
+                    cv.Optional(CONF_MAX_MISSED, default=2): cv.uint8_t,
+                    cv.Optional(CONF_CONFIRM_FRAMES, default=2): cv.int_range(1, 255),
+                    # 变化小于 deadband 时不发布, 每 500ms 至少刷新一次
+                    cv.Optional(CONF_POSITION_DEADBAND, default=0.05): cv.positive_float,  # 米
+                    cv.Optional(CONF_SPEED_DEADBAND, default=0.05): cv.positive_float,  # 米/秒
+                }
+            ),
             cv.Optional(CONF_ON_DATA): automation.validate_automation(
                 {
                     cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(LD2460DataTrigger),
@@ -47,14 +165,46 @@ CONFIG_SCHEMA = cv.All(
     )
     .extend(cv.COMPONENT_SCHEMA)
     .extend(uart.UART_DEVICE_SCHEMA),
+    validate_heatmap,
 )
 
-FINAL_VALIDATE_SCHEMA = uart.final_validate_device_schema(
-    "ld2460",
-    require_tx=True,
-    require_rx=True,
-    parity=None,
-    stop_bits=1,
+def target_slots():
+    """sensor 平台里用到的最大 target 序号, 决定 C++ 里每目标数组的长度"""
+    slots = 0
+    for conf in CORE.config.get("sensor", []):
+        if conf.get(CONF_PLATFORM) != "ld2460":
+            continue
+        for n in range(MAX_TARGETS):
+            if f"target_{n + 1}" in conf:
+                slots = max(slots, n + 1)
+    # 没配置 target 传感器时也保留一个槽位, 避免生成长度为 0 的数组
+    return max(slots, 1)
+
+
+def _final_validate_heatmap(config):
+    heatmap_config = config.get(CONF_HEATMAP)
+    if heatmap_config is None or CONF_SAVE_INTERVAL not in heatmap_config:
+        return config
+    limit = HEATMAP_PERSIST_MAX_CELLS.get(CORE.target_platform, HEATMAP_MAX_CELLS)
+    _, width, height = heatmap_grid(config)
+    if width * height > limit:
+        raise cv.Invalid(
+            f"heatmap grid {width}x{height} too large to persist on {CORE.target_platform} (max {limit} cells), "
+            f"increase {CONF_CELL_SIZE}, reduce {CONF_RANGE} or remove {CONF_SAVE_INTERVAL}",
+            path=[CONF_HEATMAP, CONF_SAVE_INTERVAL],
+        )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = cv.All(
+    uart.final_validate_device_schema(
+        "ld2460",
+        require_tx=True,
+        require_rx=True,
+        parity=None,
+        stop_bits=1,
+    ),
+    _final_validate_heatmap,
 )
 
 
@@ -62,6 +212,7 @@ async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
     await uart.register_uart_device(var, config)
+    cg.add_define("LD2460_TARGET_SLOTS", target_slots())
 
     cg.add(var.set_height_(config[CONF_HEIGHT]))
     cg.add(var.set_angle_(config[CONF_ANGLE]))
@@ -70,6 +221,40 @@ async def to_code(config):
     cg.add(var.set_detect_start_angle_(config[CONF_DETECT_START_ANGLE]))
     cg.add(var.set_detect_end_angle_(config[CONF_DETECT_END_ANGLE]))
     cg.add(var.set_sensitivity_(config[CONF_SENSITIVITY]))
+    if tracking_config := config.get(CONF_TRACKING):
+        cg.add(var.set_tracking(True))
+        tracker = var.get_tracker()
+        cg.add(tracker.set_gate(tracking_config[CONF_GATE]))
+        cg.add(tracker.set_noise(tracking_config[CONF_PROCESS_NOISE], tracking_config[CONF_MEASUREMENT_NOISE]))
+        cg.add(tracker.set_max_missed(tracking_config[CONF_MAX_MISSED]))
+        cg.add(tracker.set_confirm_frames(tracking_config[CONF_CONFIRM_FRAMES]))
+        cg.add(var.set_publish_deadbands(tracking_config[CONF_POSITION_DEADBAND],
+                                         tracking_config[CONF_SPEED_DEADBAND]))
+    for zone_conf in config.get(CONF_ZONES, []):
+        zone = cg.new_Pvariable(zone_conf[CONF_ID])
+        if rect := zone_conf.get(CONF_RECTANGLE):
+            points = [(rect[CONF_X_MIN], rect[CONF_Y_MIN]), (rect[CONF_X_MAX], rect[CONF_Y_MIN]),
+                      (rect[CONF_X_MAX], rect[CONF_Y_MAX]), (rect[CONF_X_MIN], rect[CONF_Y_MAX])]
+        else:
+            points = zone_conf[CONF_POLYGON]
+        for x, y in points:
+            cg.add(zone.add_point(x, y))
+        cg.add(zone.set_margin(zone_conf[CONF_MARGIN]))
+        cg.add(zone.set_entry_delay(zone_conf[CONF_ENTRY_DELAY]))
+        cg.add(zone.set_exit_delay(zone_conf[CONF_EXIT_DELAY]))
+        cg.add(var.add_zone(zone))
+    if heatmap_config := config.get(CONF_HEATMAP):
+        y_min, width, height = heatmap_grid(config)
+        cg.add(var.set_heatmap_enabled(True))
+        heatmap = var.get_heatmap()
+        cg.add(heatmap.set_grid(-heatmap_config[CONF_RANGE], y_min, heatmap_config[CONF_CELL_SIZE], width, height))
+        cg.add(heatmap.set_sample_interval(heatmap_config[CONF_SAMPLE_INTERVAL]))
+        if CONF_SAVE_INTERVAL in heatmap_config:
+            cg.add(heatmap.set_persist(True))
+            cg.add(var.set_heatmap_save_interval(heatmap_config[CONF_SAVE_INTERVAL]))
+        for conf in heatmap_config.get(CONF_ON_EXPORT, []):
+            trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
+            await automation.build_automation(trigger, [(cg.std_vector.template(cg.uint8), "x")], conf)
     for conf in config.get(CONF_ON_DATA, []):
         trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
         await automation.build_automation(trigger, [], conf)
@@ -152,4 +337,26 @@ async def ld2460_set_detect_range_to_code(config, action_id, template_arg, args)
     cg.add(var.set_detect_start_angle(detect_start_angle))
     detect_end_angle = await cg.templatable(config[CONF_DETECT_END_ANGLE], args, cg.float_)
     cg.add(var.set_detect_end_angle(detect_end_angle))
-    return var
\ No newline at end of file
+    return var
+
+LD2460ExportHeatmapAction = ld2460_ns.class_("LD2460ExportHeatmapAction", automation.Action)
+LD2460_EXPORT_HEATMAP_ACTION_SCHEMA = automation.maybe_simple_id(
+    {
+        cv.Required(CONF_ID): cv.use_id(LD2460Component),
+    }
+)
+@automation.register_action("ld2460.export_heatmap", LD2460ExportHeatmapAction, LD2460_EXPORT_HEATMAP_ACTION_SCHEMA)
+async def ld2460_export_heatmap_to_code(config, action_id, template_arg, args):
+    paren = await cg.get_variable(config[CONF_ID])
+    return cg.new_Pvariable(action_id, template_arg, paren)
+
+LD2460ResetHeatmapAction = ld2460_ns.class_("LD2460ResetHeatmapAction", automation.Action)
+LD2460_RESET_HEATMAP_ACTION_SCHEMA = automation.maybe_simple_id(
+    {
+        cv.Required(CONF_ID): cv.use_id(LD2460Component),
+    }
+)
+@automation.register_action("ld2460.reset_heatmap", LD2460ResetHeatmapAction, LD2460_RESET_HEATMAP_ACTION_SCHEMA)
+async def ld2460_reset_heatmap_to_code(config, action_id, template_arg, args):
+    paren = await cg.get_variable(config[CONF_ID])
+    return cg.new_Pvariable(action_id, template_arg, paren)
@@ -2,10 +2,10 @@ import esphome.codegen as cg
 from esphome.components import binary_sensor
 import esphome.config_validation as cv
 from esphome.const import (
-    CONF_TARGET, DEVICE_CLASS_MOTION
+    CONF_TARGET, DEVICE_CLASS_MOTION, DEVICE_CLASS_OCCUPANCY
 )
 
-from . import CONF_LD2460_ID, LD2460Component
+from . import CONF_LD2460_ID, LD2460Component, LD2460Zone, CONF_ZONES, CONF_ZONE_ID
 
 DEPENDENCIES = ["ld2460"]
 
@@ -16,7 +16,17 @@ CONFIG_SCHEMA = cv.All(
             cv.GenerateID(CONF_LD2460_ID): cv.use_id(LD2460Component),
             cv.Optional(CONF_TARGET): binary_sensor.binary_sensor_schema(
                 device_class=DEVICE_CLASS_MOTION,
-            )
+            ),
+            # 区域是否有人, 只在防抖后的状态变化时发布
+            cv.Optional(CONF_ZONES): cv.ensure_list(
+                binary_sensor.binary_sensor_schema(
+                    device_class=DEVICE_CLASS_OCCUPANCY,
+                ).extend(
+                    {
+                        cv.Required(CONF_ZONE_ID): cv.use_id(LD2460Zone),
+                    }
+                )
+            ),
         }
     )
 )
@@ -26,4 +36,8 @@ async def to_code(config):
 
     if target_config := config.get(CONF_TARGET):
         sens = await binary_sensor.new_binary_sensor(target_config)
-        cg.add(ld2460_component.set_target_binary_sensor(sens))
\ No newline at end of file
+        cg.add(ld2460_component.set_target_binary_sensor(sens))
+    for zone_config in config.get(CONF_ZONES, []):
+        zone = await cg.get_variable(zone_config[CONF_ZONE_ID])
+        sens = await binary_sensor.new_binary_sensor(zone_config)
+        cg.add(zone.set_occupancy_binary_sensor(sens))
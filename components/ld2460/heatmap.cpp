@@ -0,0 +1,122 @@
+#include "heatmap.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace ld2460 {
+
+static const char *const TAG = "ld2460.heatmap";
+
+void LD2460Heatmap::setup() {
+  size_t size = (size_t) this->width_ * this->height_;
+  // 按块对齐, 方便分块存储
+  size_t blocks = (size + LD2460_HEATMAP_BLOCK_CELLS - 1) / LD2460_HEATMAP_BLOCK_CELLS;
+  this->cells_.assign(blocks * LD2460_HEATMAP_BLOCK_CELLS, 0);
+  if (!this->persist_) {
+    return;
+  }
+  this->prefs_.reserve(blocks);
+  this->dirty_blocks_.assign(blocks, false);
+  Block block;
+  for (size_t i = 0; i < blocks; i++) {
+    this->prefs_.push_back(global_preferences->make_preference<Block>(this->block_hash_(i), true));
+    if (this->prefs_[i].load(&block)) {
+      memcpy(this->cells_.data() + i * LD2460_HEATMAP_BLOCK_CELLS, block.cells, sizeof(block.cells));
+    }
+  }
+  ESP_LOGD(TAG, "Heatmap %ux%u restored from %u blocks", this->width_, this->height_, (unsigned) blocks);
+}
+
+void LD2460Heatmap::add(float x, float y) {
+  int col = (int) std::floor((x - this->x_min_) / this->cell_size_);
+  int row = (int) std::floor((y - this->y_min_) / this->cell_size_);
+  if (col < 0 || col >= this->width_ || row < 0 || row >= this->height_) {
+    return;
+  }
+  size_t index = (size_t) row * this->width_ + col;
+  uint16_t &cell = this->cells_[index];
+  if (cell < UINT16_MAX) {
+    cell++;
+    this->mark_dirty_(index / LD2460_HEATMAP_BLOCK_CELLS);
+  }
+}
+
+void LD2460Heatmap::reset() {
+  // 不立即写 flash, 由定时保存或关机时写入, 和累加一样受 save_interval 限制
+  for (size_t i = 0; i < this->cells_.size(); i++) {
+    if (this->cells_[i] != 0) {
+      this->cells_[i] = 0;
+      this->mark_dirty_(i / LD2460_HEATMAP_BLOCK_CELLS);
+    }
+  }
+}
+
+void LD2460Heatmap::mark_dirty_(size_t block) {
+  this->dirty_ = true;
+  if (block < this->dirty_blocks_.size()) {
+    this->dirty_blocks_[block] = true;
+  }
+}
+
+void LD2460Heatmap::save() {
+  if (!this->persist_ || !this->dirty_) {
+    return;
+  }
+  Block block;
+  size_t written = 0;
+  for (size_t i = 0; i < this->prefs_.size(); i++) {
+    if (!this->dirty_blocks_[i]) {
+      continue;
+    }
+    memcpy(block.cells, this->cells_.data() + i * LD2460_HEATMAP_BLOCK_CELLS, sizeof(block.cells));
+    this->prefs_[i].save(&block);
+    this->dirty_blocks_[i] = false;
+    written++;
+  }
+  this->dirty_ = false;
+  ESP_LOGV(TAG, "Heatmap saved %u/%u blocks", (unsigned) written, (unsigned) this->prefs_.size());
+}
+
+std::vector<uint8_t> LD2460Heatmap::encode() const {
+  std::vector<uint8_t> out;
+  out.reserve(LD2460_HEATMAP_HEADER_SIZE + 64);
+  int16_t x_min = (int16_t) std::lround(this->x_min_ * 100);
+  int16_t y_min = (int16_t) std::lround(this->y_min_ * 100);
+  out.push_back('H');
+  out.push_back('M');
+  out.push_back(LD2460_HEATMAP_VERSION);
+  out.push_back((uint8_t) std::lround(this->cell_size_ * 100));
+  out.push_back(this->width_);
+  out.push_back(this->height_);
+  out.push_back(x_min & 0xFF);
+  out.push_back((x_min >> 8) & 0xFF);
+  out.push_back(y_min & 0xFF);
+  out.push_back((y_min >> 8) & 0xFF);
+  out.push_back(0);
+  size_t size = (size_t) this->width_ * this->height_;
+  size_t i = 0;
+  while (i < size) {
+    uint16_t value = this->cells_[i];
+    uint8_t run = 1;
+    while (i + run < size && run < UINT8_MAX && this->cells_[i + run] == value) {
+      run++;
+    }
+    out.push_back(run);
+    out.push_back(value & 0xFF);
+    out.push_back(value >> 8);
+    i += run;
+  }
+  return out;
+}
+
+uint32_t LD2460Heatmap::block_hash_(size_t block) const {
+  // 网格尺寸变化后旧数据不再加载
+  uint32_t hash = 0x4C443436UL ^ ((uint32_t) this->width_ << 16) ^ ((uint32_t) this->height_ << 8) ^
+                  (uint32_t) std::lround(this->cell_size_ * 100);
+  return hash + block;
+}
+
+}  // namespace ld2460
+}  // namespace esphome
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "esphome/core/preferences.h"
+
+namespace esphome {
+namespace ld2460 {
+
+static const uint8_t LD2460_HEATMAP_VERSION = 1;
+static const uint8_t LD2460_HEATMAP_HEADER_SIZE = 11;
+static const uint8_t LD2460_HEATMAP_BLOCK_CELLS = 64;
+
+// 按固定间隔采样目标位置, 累加到网格的饱和计数器里, 每个计数约等于 sample_interval 的停留时间
+class LD2460Heatmap {
+ public:
+  void set_grid(float x_min, float y_min, float cell_size, uint8_t width, uint8_t height) {
+    this->x_min_ = x_min;
+    this->y_min_ = y_min;
+    this->cell_size_ = cell_size;
+    this->width_ = width;
+    this->height_ = height;
+  }
+  void set_sample_interval(uint32_t interval) { this->sample_interval_ = interval; }
+  void set_persist(bool persist) { this->persist_ = persist; }
+
+  void setup();
+  void add(float x, float y);
+  bool should_sample(uint32_t now) const { return now - this->last_sample_ >= this->sample_interval_; }
+  void mark_sampled(uint32_t now) { this->last_sample_ = now; }
+  void reset();
+  // 只把有变化的块写入 flash
+  void save();
+  // 'H' 'M' version cell_size(cm) width height x_min(cm, i16) y_min(cm, i16) reserved, 之后是 (run u8, value u16) 游程
+  std::vector<uint8_t> encode() const;
+
+  uint8_t get_width() const { return this->width_; }
+  uint8_t get_height() const { return this->height_; }
+  float get_cell_size() const { return this->cell_size_; }
+
+ protected:
+  uint32_t block_hash_(size_t block) const;
+  void mark_dirty_(size_t block);
+
+  struct Block {
+    uint16_t cells[LD2460_HEATMAP_BLOCK_CELLS];
+  };
+
+  float x_min_{0};
+  float y_min_{0};
+  float cell_size_{0.25f};
+  uint8_t width_{0};
+  uint8_t height_{0};
+  uint32_t sample_interval_{1000};
+  uint32_t last_sample_{0};
+  bool persist_{false};
+  bool dirty_{false};  // 任意一块有变化
+  std::vector<uint16_t> cells_;
+  std::vector<ESPPreferenceObject> prefs_;
+  std::vector<bool> dirty_blocks_;  // 与 prefs_ 一一对应
+};
+
+}  // namespace ld2460
+}  // namespace esphome
@@ -1,4 +1,6 @@
 #include "ld2460.h"
+#include <cmath>
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -18,7 +20,18 @@ void LD2460Component::setup() {
   this->set_mode(this->mode_);
   this->set_detect_range(this->detect_distance_, this->detect_start_angle_, this->detect_end_angle_);
   this->set_sensitivity(this->sensitivity_);
-  this->set_timeout(1500, [this]() { this->read_all_info(); });
+#ifdef USE_SWITCH
+  if (this->enable_upload_switch_ != nullptr) {
+    this->enable_upload_switch_->turn_on();
+  }
+#endif
+  this->read_all_info();
+  if (this->heatmap_enabled_) {
+    this->heatmap_.setup();
+    if (this->heatmap_save_interval_ > 0) {
+      this->set_interval("heatmap", this->heatmap_save_interval_, [this]() { this->heatmap_.save(); });
+    }
+  }
 #ifdef USE_SELECT
   if (this->baud_rate_select_ != nullptr) {
     this->baud_rate_select_->publish_state(std::to_string(this->parent_->get_baud_rate()));
@@ -49,6 +62,23 @@ void LD2460Component::dump_config() {
   LOG_SELECT("  ", "Baud Rate", this->baud_rate_select_);
   LOG_SELECT("  ", "Sensitivity", this->sensitivity_select_);
 #endif
+  if (this->tracking_) {
+    ESP_LOGCONFIG(TAG, "  Tracking: deadband position %.2f m, speed %.2f m/s", this->position_deadband_,
+                  this->speed_deadband_);
+  }
+  for (auto *zone : this->zones_) {
+    zone->dump_config("  ");
+  }
+  if (this->heatmap_enabled_) {
+    ESP_LOGCONFIG(TAG, "  Heatmap: %ux%u cells of %.2f m, save interval %" PRIu32 " ms", this->heatmap_.get_width(),
+                  this->heatmap_.get_height(), this->heatmap_.get_cell_size(), this->heatmap_save_interval_);
+  }
+}
+
+void LD2460Component::on_shutdown() {
+  if (this->heatmap_enabled_) {
+    this->heatmap_.save();
+  }
 }
 
 void LD2460Component::parse_upload() {
@@ -69,7 +99,7 @@ void LD2460Component::parse_upload() {
   }
   uint8_t target_num = (frame_size - 11) / 4;  // number of targets
 #ifdef USE_SENSOR
-  if (this->target_number_sensor_ != nullptr) {
+  if (this->target_number_sensor_ != nullptr && !this->tracking_) {
     this->target_number_sensor_->publish_state(target_num);
   }
 #endif
@@ -83,25 +113,142 @@ void LD2460Component::parse_upload() {
     this->set_timeout("timeout", 1000, [this]() { this->target_binary_sensor_->publish_state(false); });
   }
 #endif
-  if (target_num > MAX_TARGETS ) {
+  if (target_num > MAX_TARGETS) {
     target_num = MAX_TARGETS;  // ignore extra targets
   }
+  LD2460Point targets[MAX_TARGETS];
   for (uint8_t i = 0; i < target_num; i++) {
     int16_t x = (int16_t) (this->receive_buffer[7 + i * 4]) |
                 (((int16_t) this->receive_buffer[7 + i * 4 + 1]) << 8);  // target x
     int16_t y = (int16_t) (this->receive_buffer[7 + i * 4 + 2]) |
                 (((int16_t) this->receive_buffer[7 + i * 4 + 3]) << 8);  // target y
+    targets[i].x = (float) x / 10.0f;
+    targets[i].y = (float) y / 10.0f;
+  }
+  uint32_t now = millis();
+  this->last_upload_time_ = now;
+  this->stale_ = false;
+  if (this->tracking_) {
+    this->tracker_.update(targets, target_num, now);
+    this->publish_tracks_(now);
+    // 区域和热力图也使用平滑后的位置
+    target_num = 0;
+    for (const auto &track : this->tracker_.get_tracks()) {
+      if (track.id != 0 && track.confirmed) {
+        targets[target_num].x = track.x.pos;
+        targets[target_num].y = track.y.pos;
+        target_num++;
+      }
+    }
+  } else {
+    this->publish_raw_targets_(targets, target_num);
+  }
+  for (auto *zone : this->zones_) {
+    zone->update(targets, target_num, now);
+  }
+  if (this->heatmap_enabled_ && this->heatmap_.should_sample(now)) {
+    for (uint8_t i = 0; i < target_num; i++) {
+      this->heatmap_.add(targets[i].x, targets[i].y);
+    }
+    this->heatmap_.mark_sampled(now);
+  }
+  this->receive_buffer.erase(this->receive_buffer.begin(), this->receive_buffer.begin() + frame_size);
+  this->data_callback_.call();
+}
+
+void LD2460Component::publish_raw_targets_(const LD2460Point *targets, uint8_t num) {
 #ifdef USE_SENSOR
+  for (uint8_t i = 0; i < num && i < LD2460_TARGET_SLOTS; i++) {
     if (this->target_x_sensors_[i] != nullptr) {
-      this->target_x_sensors_[i]->publish_state((float) x / 10.0f);
+      this->target_x_sensors_[i]->publish_state(targets[i].x);
     }
     if (this->target_y_sensors_[i] != nullptr) {
-      this->target_y_sensors_[i]->publish_state((float) y / 10.0f);
+      this->target_y_sensors_[i]->publish_state(targets[i].y);
     }
+  }
 #endif
+}
+
+void LD2460Component::publish_tracks_(uint32_t now) {
+  const auto &tracks = this->tracker_.get_tracks();
+  uint8_t confirmed = 0;
+  for (uint8_t i = 0; i < MAX_TARGETS; i++) {
+    const LD2460Track &track = tracks[i];
+    bool active = track.id != 0 && track.confirmed;
+    confirmed += active;
+    if (i >= LD2460_TARGET_SLOTS) {
+      continue;  // 没有对应传感器的槽位只参与计数
+    }
+    LD2460PublishedTarget &pub = this->published_[i];
+    if (!active) {
+      if (pub.id != 0) {
+        this->clear_target_(i);  // 轨迹消失
+        pub = LD2460PublishedTarget{};
+      }
+      continue;
+    }
+    bool born = pub.id != track.id;
+    if (born) {
+      pub = LD2460PublishedTarget{};
+      pub.id = track.id;
+#ifdef USE_SENSOR
+      if (this->target_track_id_sensors_[i] != nullptr) {
+        this->target_track_id_sensors_[i]->publish_state(track.id);
+      }
+#endif
+    }
+    // 轨迹每帧都在更新, 只在出现, 变化超过 deadband 或者到了刷新时间才发布
+    bool refresh = born || now - pub.time >= LD2460_TRACK_REFRESH;
+    float speed = track.speed();
+    bool moved = std::fabs(track.x.pos - pub.x) >= this->position_deadband_ ||
+                 std::fabs(track.y.pos - pub.y) >= this->position_deadband_;
+    if (refresh || moved) {
+      pub.x = track.x.pos;
+      pub.y = track.y.pos;
+#ifdef USE_SENSOR
+      if (this->target_x_sensors_[i] != nullptr) {
+        this->target_x_sensors_[i]->publish_state(pub.x);
+      }
+      if (this->target_y_sensors_[i] != nullptr) {
+        this->target_y_sensors_[i]->publish_state(pub.y);
+      }
+#endif
+    }
+    if (refresh || std::fabs(speed - pub.speed) >= this->speed_deadband_) {
+      pub.speed = speed;
+#ifdef USE_SENSOR
+      if (this->target_speed_sensors_[i] != nullptr) {
+        this->target_speed_sensors_[i]->publish_state(speed);
+      }
+#endif
+    }
+    if (refresh) {
+      pub.time = now;
+    }
   }
-  this->receive_buffer.erase(this->receive_buffer.begin(), this->receive_buffer.begin() + frame_size);
-  this->data_callback_.call();
+#ifdef USE_SENSOR
+  if (this->target_number_sensor_ != nullptr && confirmed != this->last_track_count_) {
+    this->target_number_sensor_->publish_state(confirmed);
+  }
+#endif
+  this->last_track_count_ = confirmed;
+}
+
+void LD2460Component::clear_target_(uint8_t i) {
+#ifdef USE_SENSOR
+  if (this->target_x_sensors_[i] != nullptr) {
+    this->target_x_sensors_[i]->publish_state(NAN);
+  }
+  if (this->target_y_sensors_[i] != nullptr) {
+    this->target_y_sensors_[i]->publish_state(NAN);
+  }
+  if (this->target_speed_sensors_[i] != nullptr) {
+    this->target_speed_sensors_[i]->publish_state(NAN);
+  }
+  if (this->target_track_id_sensors_[i] != nullptr) {
+    this->target_track_id_sensors_[i]->publish_state(NAN);
+  }
+#endif
 }
 
 void LD2460Component::parse_ack() {
@@ -120,6 +267,9 @@ void LD2460Component::parse_ack() {
     this->receive_buffer.clear();
     return;
   }
+  if (this->command_waiting_ && this->command_sent_.ack && cmd == this->command_sent_.opcode) {
+    this->command_waiting_ = false;  // 收到回执, 可以发下一条
+  }
   switch (cmd) {
     case 0x06: {  // 雷达开启/关闭上报功能设置回执
       uint8_t d = this->receive_buffer[7];
@@ -257,12 +407,33 @@ void LD2460Component::parse_ack() {
 }
 
 void LD2460Component::loop() {
-  if (!this->task_queue_.empty()) {
-    auto task = std::move(this->task_queue_.front());
-    if (task) {
-      task();
+  uint32_t now = millis();
+  // 没有目标时雷达不上报, 超时后按空帧处理区域和轨迹
+  if (now - this->last_upload_time_ > LD2460_STALE_TIMEOUT) {
+    for (auto *zone : this->zones_) {
+      zone->update(nullptr, 0, now);
+    }
+    if (!this->stale_) {
+      this->stale_ = true;
+      if (this->tracking_) {
+        this->tracker_.reset();
+        this->publish_tracks_(now);
+      }
     }
-    this->task_queue_.pop();
+  }
+  if (this->command_waiting_ && now - this->command_sent_time_ >= this->command_sent_.timeout) {
+    if (this->command_sent_.ack) {
+      ESP_LOGW(TAG, "no ack for cmd %02X", this->command_sent_.opcode);
+    }
+    this->command_waiting_ = false;
+  }
+  if (!this->command_waiting_ && this->command_count_ > 0) {
+    this->command_sent_ = this->command_queue_[this->command_head_];
+    this->command_head_ = (this->command_head_ + 1) % LD2460_COMMAND_QUEUE_SIZE;
+    this->command_count_--;
+    this->write_command_(this->command_sent_);
+    this->command_sent_time_ = now;
+    this->command_waiting_ = true;
   }
   uint8_t peeked;
   while (this->available()) {
@@ -325,12 +496,12 @@ void LD2460Component::get_version() {
 
 void LD2460Component::restart_and_read_all_info() {
   this->restart();
-  this->set_timeout(1500, [this]() { this->read_all_info(); });
+  this->read_all_info();
 }
 
 void LD2460Component::restart() {
   uint8_t data = 0x01;
-  this->send_command(0x0D, &data, 1);
+  this->send_command(0x0D, &data, 1, false, LD2460_RESTART_TIME);  // 重启没有回执, 等雷达启动完成
 }
 
 void LD2460Component::set_baud_rate(const std::string &baud_rate) {
@@ -357,13 +528,13 @@ void LD2460Component::set_baud_rate(const std::string &baud_rate) {
   if (this->parent_->get_baud_rate() != new_baud_rate) {
     this->parent_->set_baud_rate(new_baud_rate);
   }
-  this->set_timeout(200, [this]() { this->restart(); });
+  this->restart();
 }
 
 void LD2460Component::factory_reset() {
   uint8_t data = 0x01;
   this->send_command(0x10, &data, 1);
-  this->set_timeout(200, [this]() { this->restart_and_read_all_info(); });
+  this->restart_and_read_all_info();
 }
 
 void LD2460Component::set_detect_range(float distance, float start_angle, float end_angle) {
@@ -405,15 +576,44 @@ void LD2460Component::read_all_info() {
   this->get_sensitivity();
 }
 
-void LD2460Component::send_command(uint8_t command, const uint8_t *data, uint16_t data_size) {
-  uint16_t total_size = data_size + 11;  // head(4) + cmd(1) + len(2) + data + tail(4)
+void LD2460Component::export_heatmap() {
+  if (!this->heatmap_enabled_) {
+    ESP_LOGW(TAG, "heatmap is not configured");
+    return;
+  }
+  this->heatmap_callback_.call(this->heatmap_.encode());
+}
+
+void LD2460Component::reset_heatmap() {
+  if (this->heatmap_enabled_) {
+    this->heatmap_.reset();
+  }
+}
+
+void LD2460Component::send_command(uint8_t command, const uint8_t *data, uint8_t data_size, bool ack,
+                                   uint16_t timeout) {
+  if (this->command_count_ >= LD2460_COMMAND_QUEUE_SIZE || data_size > LD2460_COMMAND_MAX_DATA) {
+    ESP_LOGW(TAG, "command queue full, drop cmd %02X", command);
+    return;
+  }
+  LD2460Command &cmd = this->command_queue_[(this->command_head_ + this->command_count_) % LD2460_COMMAND_QUEUE_SIZE];
+  cmd.opcode = command;
+  cmd.size = data_size;
+  if (data != nullptr) {
+    memcpy(cmd.data, data, data_size);
+  }
+  cmd.ack = ack;
+  cmd.timeout = timeout;
+  this->command_count_++;
+}
+
+void LD2460Component::write_command_(const LD2460Command &command) {
+  uint16_t total_size = command.size + 11;  // head(4) + cmd(1) + len(2) + data + tail(4)
   this->write_array(LD2460_CMD_HEAD, 4);
-  this->write_byte(command);
+  this->write_byte(command.opcode);
   this->write_byte((uint8_t) (total_size & 0xFF));         // length low byte
   this->write_byte((uint8_t) ((total_size >> 8) & 0xFF));  // length high byte
-  if (data != nullptr) {
-    this->write_array(data, data_size);
-  }
+  this->write_array(command.data, command.size);
   this->write_array(LD2460_CMD_TAIL, 4);
   this->flush();
 }
@@ -2,11 +2,13 @@
 
 #include <array>
 #include <vector>
-#include <queue>
 #include "esphome/core/defines.h"
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
 #include "esphome/components/uart/uart.h"
+#include "zone.h"
+#include "heatmap.h"
+#include "tracker.h"
 #ifdef USE_SENSOR
 #include "esphome/components/sensor/sensor.h"
 #endif
@@ -32,7 +34,36 @@
 namespace esphome {
 namespace ld2460 {
 
-#define MAX_TARGETS 5
+// 由 __init__.py 按 yaml 里配置的最大 target 序号生成, 未生成时按协议上限
+#ifndef LD2460_TARGET_SLOTS
+#define LD2460_TARGET_SLOTS MAX_TARGETS
+#endif
+static_assert(LD2460_TARGET_SLOTS >= 1 && LD2460_TARGET_SLOTS <= MAX_TARGETS, "LD2460_TARGET_SLOTS out of range");
+static const uint32_t LD2460_STALE_TIMEOUT = 1000;
+static const uint8_t LD2460_COMMAND_MAX_DATA = 5;
+static const uint8_t LD2460_COMMAND_QUEUE_SIZE = 16;
+static const uint16_t LD2460_ACK_TIMEOUT = 300;
+static const uint16_t LD2460_RESTART_TIME = 1500;
+// 跟踪模式下变化不超过 deadband 也至少这么久重发一次, 要短于 x/y 传感器默认的 1s timeout 过滤器
+static const uint32_t LD2460_TRACK_REFRESH = 500;
+
+// 每个 target 槽位上次发布的值, 用于只在变化时发布
+struct LD2460PublishedTarget {
+  uint16_t id{0};
+  float x{NAN};
+  float y{NAN};
+  float speed{NAN};
+  uint32_t time{0};
+};
+
+// 待发送的命令, 上一条命令收到回执或超时后才发送下一条
+struct LD2460Command {
+  uint8_t opcode;
+  uint8_t size;
+  uint8_t data[LD2460_COMMAND_MAX_DATA];
+  bool ack;          // 是否等待同 opcode 的回执
+  uint16_t timeout;  // 等待回执的最长时间, 不等回执时为固定间隔
+};
 
 class LD2460Component : public Component, public uart::UARTDevice {
 #ifdef USE_SENSOR
@@ -69,12 +100,20 @@ class LD2460Component : public Component, public uart::UARTDevice {
   float get_setup_priority() const override { return setup_priority::DATA; }
   void dump_config() override;
   void loop() override;
+  void on_shutdown() override;
 
-  std::queue<std::function<void()>> task_queue_{};
 #ifdef USE_SENSOR
   void set_target_x_sensor(uint8_t n, sensor::Sensor *target_x_sensor) { this->target_x_sensors_[n] = target_x_sensor; }
   void set_target_y_sensor(uint8_t n, sensor::Sensor *target_y_sensor) { this->target_y_sensors_[n] = target_y_sensor; }
+  void set_target_speed_sensor(uint8_t n, sensor::Sensor *s) { this->target_speed_sensors_[n] = s; }
+  void set_target_track_id_sensor(uint8_t n, sensor::Sensor *s) { this->target_track_id_sensors_[n] = s; }
 #endif
+  void set_tracking(bool tracking) { this->tracking_ = tracking; }
+  void set_publish_deadbands(float position, float speed) {
+    this->position_deadband_ = position;
+    this->speed_deadband_ = speed;
+  }
+  LD2460Tracker &get_tracker() { return this->tracker_; }
   void set_height_(float height) {this->height_ = height;} // 安装高度
   void set_angle_(float angle) {this->angle_ = angle;} // 安装角度
   void set_mode_(const std::string mode) {this->mode_ = mode;};
@@ -97,6 +136,16 @@ class LD2460Component : public Component, public uart::UARTDevice {
   void set_sensitivity(const std::string &sensitivity);
   void get_sensitivity();
 
+  void add_zone(LD2460Zone *zone) { this->zones_.push_back(zone); }
+  void set_heatmap_enabled(bool enabled) { this->heatmap_enabled_ = enabled; }
+  void set_heatmap_save_interval(uint32_t interval) { this->heatmap_save_interval_ = interval; }
+  LD2460Heatmap &get_heatmap() { return this->heatmap_; }
+  void export_heatmap();
+  void reset_heatmap();
+  void add_on_heatmap_callback(std::function<void(const std::vector<uint8_t> &)> &&callback) {
+    this->heatmap_callback_.add(std::move(callback));
+  }
+
   void restart_and_read_all_info();
   void read_all_info();
   void add_on_data_callback(std::function<void()> &&callback) {
@@ -112,12 +161,38 @@ class LD2460Component : public Component, public uart::UARTDevice {
   std::string sensitivity_;
 
   LazyCallbackManager<void()> data_callback_;
+  std::vector<LD2460Zone *> zones_;
+  bool heatmap_enabled_{false};
+  uint32_t heatmap_save_interval_{0};
+  LD2460Heatmap heatmap_;
+  LazyCallbackManager<void(const std::vector<uint8_t> &)> heatmap_callback_;
+  uint32_t last_upload_time_{0};
 
 #ifdef USE_SENSOR
-  std::array<sensor::Sensor *, MAX_TARGETS> target_x_sensors_{};
-  std::array<sensor::Sensor *, MAX_TARGETS> target_y_sensors_{};
+  std::array<sensor::Sensor *, LD2460_TARGET_SLOTS> target_x_sensors_{};
+  std::array<sensor::Sensor *, LD2460_TARGET_SLOTS> target_y_sensors_{};
+  std::array<sensor::Sensor *, LD2460_TARGET_SLOTS> target_speed_sensors_{};
+  std::array<sensor::Sensor *, LD2460_TARGET_SLOTS> target_track_id_sensors_{};
 #endif
-  void send_command(uint8_t command, const uint8_t *data, uint16_t data_size);
+  bool tracking_{false};
+  LD2460Tracker tracker_;
+  float position_deadband_{0.05f};
+  float speed_deadband_{0.05f};
+  std::array<LD2460PublishedTarget, LD2460_TARGET_SLOTS> published_{};
+  uint8_t last_track_count_{0};
+  bool stale_{false};
+  void publish_raw_targets_(const LD2460Point *targets, uint8_t num);
+  void publish_tracks_(uint32_t now);
+  void clear_target_(uint8_t i);
+  void send_command(uint8_t command, const uint8_t *data, uint8_t data_size, bool ack = true,
+                    uint16_t timeout = LD2460_ACK_TIMEOUT);
+  void write_command_(const LD2460Command &command);
+  std::array<LD2460Command, LD2460_COMMAND_QUEUE_SIZE> command_queue_{};
+  uint8_t command_head_{0};
+  uint8_t command_count_{0};
+  bool command_waiting_{false};
+  LD2460Command command_sent_{};
+  uint32_t command_sent_time_{0};
   std::vector<uint8_t> receive_buffer;
   bool head_found{false};
 
@@ -184,6 +259,31 @@ template<typename... Ts> class LD2460SetDetectRangeAction : public Action<Ts...>
   LD2460Component *ld2460_;
 };
 
+template<typename... Ts> class LD2460ExportHeatmapAction : public Action<Ts...> {
+ public:
+  LD2460ExportHeatmapAction(LD2460Component *ld2460) : ld2460_(ld2460) {}
+  void play(const Ts &...x) override { this->ld2460_->export_heatmap(); }
+
+ protected:
+  LD2460Component *ld2460_;
+};
+
+template<typename... Ts> class LD2460ResetHeatmapAction : public Action<Ts...> {
+ public:
+  LD2460ResetHeatmapAction(LD2460Component *ld2460) : ld2460_(ld2460) {}
+  void play(const Ts &...x) override { this->ld2460_->reset_heatmap(); }
+
+ protected:
+  LD2460Component *ld2460_;
+};
+
+class LD2460HeatmapTrigger : public Trigger<std::vector<uint8_t>> {
+ public:
+  explicit LD2460HeatmapTrigger(LD2460Component *parent) {
+    parent->add_on_heatmap_callback([this](const std::vector<uint8_t> &data) { this->trigger(data); });
+  }
+};
+
 class LD2460DataTrigger : public Trigger<> {
 public:
   explicit LD2460DataTrigger(LD2460Component *parent) {
@@ -1,14 +1,15 @@
 import esphome.codegen as cg
 from esphome.components import sensor
 import esphome.config_validation as cv
+import esphome.final_validate as fv
 from esphome.const import (
     CONF_ID,
     ICON_ACCOUNT,
     CONF_X, CONF_Y, STATE_CLASS_MEASUREMENT, DEVICE_CLASS_DISTANCE, UNIT_METER, ICON_PULSE,
-    ICON_HEART_PULSE, UNIT_BEATS_PER_MINUTE
+    ICON_HEART_PULSE, UNIT_BEATS_PER_MINUTE, CONF_SPEED, DEVICE_CLASS_SPEED, UNIT_METER_PER_SECOND
 )
 
-from . import CONF_LD2460_ID, LD2460Component, MAX_TARGETS
+from . import CONF_LD2460_ID, LD2460Component, MAX_TARGETS, LD2460Zone, CONF_ZONES, CONF_ZONE_ID, CONF_TRACKING
 
 DEPENDENCIES = ["ld2460"]
 
@@ -16,6 +17,8 @@ CONF_TARGET_NUMBER = "target_number"
 CONF_TARGET = "target"
 ICON_ALPHA_X_BOX_OUTLINE = "mdi:alpha-x-box-outline"
 ICON_ALPHA_Y_BOX_OUTLINE = "mdi:alpha-y-box-outline"
+ICON_SPEEDOMETER = "mdi:speedometer"
+CONF_TRACK_ID = "track_id"
 
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
@@ -34,6 +37,18 @@ CONFIG_SCHEMA = cv.All(
                     },
                 ],
             ),
+            # 区域内目标数
+            cv.Optional(CONF_ZONES): cv.ensure_list(
+                sensor.sensor_schema(
+                    icon=ICON_ACCOUNT,
+                    accuracy_decimals=0,
+                    state_class=STATE_CLASS_MEASUREMENT,
+                ).extend(
+                    {
+                        cv.Required(CONF_ZONE_ID): cv.use_id(LD2460Zone),
+                    }
+                )
+            ),
         }
     ).extend(
         {
@@ -60,12 +75,38 @@ CONFIG_SCHEMA = cv.All(
                                                                   }
                                                               },
                                                           ]),
+                # 以下两项需要开启 tracking, 否则配置校验报错
+                cv.Optional(CONF_SPEED): sensor.sensor_schema(device_class=DEVICE_CLASS_SPEED,
+                                                              icon=ICON_SPEEDOMETER,
+                                                              unit_of_measurement=UNIT_METER_PER_SECOND,
+                                                              accuracy_decimals=2),
+                cv.Optional(CONF_TRACK_ID): sensor.sensor_schema(icon=ICON_ACCOUNT,
+                                                                 accuracy_decimals=0),
             })
             for n in range(MAX_TARGETS)
         }
     )
 )
 
+def _final_validate(config):
+    """speed 和 track_id 只有开启 tracking 才会发布"""
+    full_config = fv.full_config.get()
+    parent_path = full_config.get_path_for_id(config[CONF_LD2460_ID])[:-1]
+    parent_config = full_config.get_config_for_path(parent_path)
+    if CONF_TRACKING in parent_config:
+        return config
+    for n in range(MAX_TARGETS):
+        target = f"{CONF_TARGET}_{n + 1}"
+        for key in (CONF_SPEED, CONF_TRACK_ID):
+            if key in config.get(target, {}):
+                raise cv.Invalid(f"{key} requires {CONF_TRACKING} to be configured on the ld2460 component",
+                                 path=[target, key])
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
+
+
 async def to_code(config):
     ld2460_component = await cg.get_variable(config[CONF_LD2460_ID])
 
@@ -73,6 +114,11 @@ async def to_code(config):
         sens = await sensor.new_sensor(target_number_config)
         cg.add(ld2460_component.set_target_number_sensor(sens))
 
+    for zone_config in config.get(CONF_ZONES, []):
+        zone = await cg.get_variable(zone_config[CONF_ZONE_ID])
+        sens = await sensor.new_sensor(zone_config)
+        cg.add(zone.set_count_sensor(sens))
+
     for n in range(MAX_TARGETS):
         if target_config := config.get(f"{CONF_TARGET}_{n + 1}"):
             if conf := target_config.get(CONF_X):
@@ -80,4 +126,10 @@ async def to_code(config):
                 cg.add(ld2460_component.set_target_x_sensor(n, sens))
             if conf := target_config.get(CONF_Y):
                 sens = await sensor.new_sensor(conf)
-                cg.add(ld2460_component.set_target_y_sensor(n, sens))
\ No newline at end of file
+                cg.add(ld2460_component.set_target_y_sensor(n, sens))
+            if conf := target_config.get(CONF_SPEED):
+                sens = await sensor.new_sensor(conf)
+                cg.add(ld2460_component.set_target_speed_sensor(n, sens))
+            if conf := target_config.get(CONF_TRACK_ID):
+                sens = await sensor.new_sensor(conf)
+                cg.add(ld2460_component.set_target_track_id_sensor(n, sens))
\ No newline at end of file
@@ -10,11 +10,6 @@ class EnableUploadSwitch : public switch_::Switch, public Parented<LD2460Compone
  public:
   EnableUploadSwitch() = default;
 
-  void init() {
-    // parent_ != nullptr 之后再调用，也就是cg.register_parented之后才能有
-    this->parent_->task_queue_.push([this]() { this->turn_on(); });
-  }
-
  protected:
   void write_state(bool state) override;
 };
@@ -0,0 +1,131 @@
+#include "tracker.h"
+
+namespace esphome {
+namespace ld2460 {
+
+void LD2460Axis::predict(float dt, float q) {
+  // x = F x, P = F P F' + Q, Q 按白噪声加速度离散化
+  float q2 = q * q;
+  float dt2 = dt * dt;
+  this->pos += this->vel * dt;
+  this->p00 += dt * (2 * this->p01 + dt * this->p11) + q2 * dt2 * dt2 / 4;
+  this->p01 += dt * this->p11 + q2 * dt2 * dt / 2;
+  this->p11 += q2 * dt2;
+}
+
+void LD2460Axis::correct(float z, float r) {
+  float s = this->p00 + r * r;
+  float k0 = this->p00 / s;
+  float k1 = this->p01 / s;
+  float residual = z - this->pos;
+  this->pos += k0 * residual;
+  this->vel += k1 * residual;
+  float p00 = this->p00;
+  float p01 = this->p01;
+  this->p00 = (1 - k0) * p00;
+  this->p01 = (1 - k0) * p01;
+  this->p11 -= k1 * p01;
+}
+
+void LD2460Tracker::update(const LD2460Point *targets, uint8_t count, uint32_t now) {
+  float dt = this->last_update_ == 0 ? 0.0f : (now - this->last_update_) / 1000.0f;
+  this->last_update_ = now;
+  if (count > MAX_TARGETS) {
+    count = MAX_TARGETS;
+  }
+  for (auto &track : this->tracks_) {
+    if (track.id != 0 && dt > 0) {
+      track.x.predict(dt, this->process_noise_);
+      track.y.predict(dt, this->process_noise_);
+    }
+  }
+
+  // 门限内按预测位置的距离从小到大贪心匹配
+  std::array<int8_t, MAX_TARGETS> track_target;
+  std::array<bool, MAX_TARGETS> target_used{};
+  track_target.fill(-1);
+  float gate2 = this->gate_ * this->gate_;
+  while (true) {
+    float best = gate2;
+    int8_t best_t = -1;
+    int8_t best_d = -1;
+    for (uint8_t t = 0; t < MAX_TARGETS; t++) {
+      const LD2460Track &track = this->tracks_[t];
+      if (track.id == 0 || track_target[t] >= 0) {
+        continue;
+      }
+      for (uint8_t d = 0; d < count; d++) {
+        if (target_used[d]) {
+          continue;
+        }
+        float dx = targets[d].x - track.x.pos;
+        float dy = targets[d].y - track.y.pos;
+        float dist2 = dx * dx + dy * dy;
+        if (dist2 <= best) {
+          best = dist2;
+          best_t = t;
+          best_d = d;
+        }
+      }
+    }
+    if (best_t < 0) {
+      break;
+    }
+    track_target[best_t] = best_d;
+    target_used[best_d] = true;
+  }
+
+  for (uint8_t t = 0; t < MAX_TARGETS; t++) {
+    LD2460Track &track = this->tracks_[t];
+    if (track.id == 0) {
+      continue;
+    }
+    if (track_target[t] < 0) {
+      // 漏检时保留预测值, 超过 max_missed 帧则删除
+      if (++track.missed > this->max_missed_) {
+        track = LD2460Track{};
+      }
+      continue;
+    }
+    const LD2460Point &target = targets[track_target[t]];
+    track.x.correct(target.x, this->measurement_noise_);
+    track.y.correct(target.y, this->measurement_noise_);
+    track.missed = 0;
+    if (track.hits < 0xFF) {
+      track.hits++;
+    }
+    if (track.hits >= this->confirm_frames_) {
+      track.confirmed = true;
+    }
+  }
+
+  // 没匹配上的目标新建轨迹
+  for (uint8_t d = 0; d < count; d++) {
+    if (target_used[d]) {
+      continue;
+    }
+    for (auto &track : this->tracks_) {
+      if (track.id == 0) {
+        this->birth_(track, targets[d]);
+        break;
+      }
+    }
+  }
+}
+
+void LD2460Tracker::birth_(LD2460Track &track, const LD2460Point &target) {
+  track = LD2460Track{};
+  track.id = this->next_id_++;
+  if (this->next_id_ == 0) {
+    this->next_id_ = 1;
+  }
+  float r2 = this->measurement_noise_ * this->measurement_noise_;
+  // 初始速度未知, 方差取 (1 m/s)^2
+  track.x.init(target.x, r2, 1.0f);
+  track.y.init(target.y, r2, 1.0f);
+  track.hits = 1;
+  track.confirmed = track.hits >= this->confirm_frames_;
+}
+
+}  // namespace ld2460
+}  // namespace esphome
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cmath>
+#include "zone.h"
+
+namespace esphome {
+namespace ld2460 {
+
+#define MAX_TARGETS 5
+
+// 单轴匀速模型的卡尔曼滤波, x/y 两轴相互独立
+struct LD2460Axis {
+  float pos{0};  // 米
+  float vel{0};  // 米/秒
+  float p00{0};
+  float p01{0};
+  float p11{0};
+
+  void init(float z, float r, float v) {
+    this->pos = z;
+    this->vel = 0;
+    this->p00 = r;
+    this->p01 = 0;
+    this->p11 = v;
+  }
+  void predict(float dt, float q);
+  void correct(float z, float r);
+};
+
+struct LD2460Track {
+  uint16_t id{0};  // 0 表示空闲
+  LD2460Axis x;
+  LD2460Axis y;
+  uint8_t hits{0};
+  uint8_t missed{0};
+  bool confirmed{false};
+
+  float speed() const { return std::sqrt(this->x.vel * this->x.vel + this->y.vel * this->y.vel); }
+};
+
+// 逐帧关联目标坐标, 每条轨迹固定占用一个槽位, 槽位号即对外的 target 序号
+class LD2460Tracker {
+ public:
+  void set_gate(float gate) { this->gate_ = gate; }
+  void set_noise(float process, float measurement) {
+    this->process_noise_ = process;
+    this->measurement_noise_ = measurement;
+  }
+  void set_max_missed(uint8_t max_missed) { this->max_missed_ = max_missed; }
+  void set_confirm_frames(uint8_t confirm_frames) { this->confirm_frames_ = confirm_frames; }
+
+  void update(const LD2460Point *targets, uint8_t count, uint32_t now);
+  void reset() {
+    this->tracks_.fill(LD2460Track{});
+    this->last_update_ = 0;
+  }
+  const std::array<LD2460Track, MAX_TARGETS> &get_tracks() const { return this->tracks_; }
+
+ protected:
+  void birth_(LD2460Track &track, const LD2460Point &target);
+
+  float gate_{1.0f};                // 米
+  float process_noise_{1.0f};       // 加速度, 米/秒^2
+  float measurement_noise_{0.15f};  // 米
+  uint8_t max_missed_{2};
+  uint8_t confirm_frames_{2};
+
+  std::array<LD2460Track, MAX_TARGETS> tracks_{};
+  uint16_t next_id_{1};
+  uint32_t last_update_{0};
+};
+
+}  // namespace ld2460
+}  // namespace esphome
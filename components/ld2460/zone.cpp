@@ -0,0 +1,88 @@
+#include "zone.h"
+#include <cmath>
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace ld2460 {
+
+static const char *const TAG = "ld2460.zone";
+
+void LD2460Zone::update(const LD2460Point *targets, uint8_t count, uint32_t now) {
+  uint8_t inside = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    if (this->contains_(targets[i]) || (this->count_ > 0 && this->edge_distance_(targets[i]) <= this->margin_)) {
+      inside++;
+    }
+  }
+  if (inside != this->pending_count_) {
+    this->pending_count_ = inside;
+    this->pending_since_ = now;
+  }
+  if (this->published_ && this->pending_count_ == this->count_) {
+    return;
+  }
+  // 目标数增加按 entry_delay 防抖, 减少按 exit_delay 防抖
+  uint32_t delay = this->pending_count_ > this->count_ ? this->entry_delay_ : this->exit_delay_;
+  if (this->published_ && now - this->pending_since_ < delay) {
+    return;
+  }
+  bool was_occupied = this->count_ > 0;
+  this->count_ = this->pending_count_;
+#ifdef USE_SENSOR
+  if (this->count_sensor_ != nullptr) {
+    this->count_sensor_->publish_state(this->count_);
+  }
+#endif
+#ifdef USE_BINARY_SENSOR
+  if (this->occupancy_binary_sensor_ != nullptr && (!this->published_ || was_occupied != (this->count_ > 0))) {
+    this->occupancy_binary_sensor_->publish_state(this->count_ > 0);
+  }
+#endif
+  this->published_ = true;
+}
+
+bool LD2460Zone::contains_(const LD2460Point &p) const {
+  // 射线法
+  bool inside = false;
+  size_t n = this->polygon_.size();
+  for (size_t i = 0, j = n - 1; i < n; j = i++) {
+    const LD2460Point &a = this->polygon_[i];
+    const LD2460Point &b = this->polygon_[j];
+    if ((a.y > p.y) != (b.y > p.y) && p.x < (b.x - a.x) * (p.y - a.y) / (b.y - a.y) + a.x) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+float LD2460Zone::edge_distance_(const LD2460Point &p) const {
+  float best = INFINITY;
+  size_t n = this->polygon_.size();
+  for (size_t i = 0, j = n - 1; i < n; j = i++) {
+    const LD2460Point &a = this->polygon_[j];
+    const LD2460Point &b = this->polygon_[i];
+    float dx = b.x - a.x;
+    float dy = b.y - a.y;
+    float len2 = dx * dx + dy * dy;
+    float t = len2 > 0 ? ((p.x - a.x) * dx + (p.y - a.y) * dy) / len2 : 0;
+    t = t < 0 ? 0 : (t > 1 ? 1 : t);
+    float ex = a.x + t * dx - p.x;
+    float ey = a.y + t * dy - p.y;
+    best = std::fmin(best, std::sqrt(ex * ex + ey * ey));
+  }
+  return best;
+}
+
+void LD2460Zone::dump_config(const char *prefix) const {
+  ESP_LOGCONFIG(TAG, "%sZone: %u points, margin %.2f m, entry %" PRIu32 " ms, exit %" PRIu32 " ms", prefix,
+                (unsigned) this->polygon_.size(), this->margin_, this->entry_delay_, this->exit_delay_);
+#ifdef USE_BINARY_SENSOR
+  LOG_BINARY_SENSOR(prefix, "  Occupancy", this->occupancy_binary_sensor_);
+#endif
+#ifdef USE_SENSOR
+  LOG_SENSOR(prefix, "  Count", this->count_sensor_);
+#endif
+}
+
+}  // namespace ld2460
+}  // namespace esphome
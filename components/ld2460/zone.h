@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "esphome/core/defines.h"
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+#ifdef USE_BINARY_SENSOR
+#include "esphome/components/binary_sensor/binary_sensor.h"
+#endif
+
+namespace esphome {
+namespace ld2460 {
+
+struct LD2460Point {
+  float x;  // 米
+  float y;
+};
+
+// 多边形区域, 每帧统计区域内目标数, 防抖后只在变化时发布
+class LD2460Zone {
+ public:
+  void add_point(float x, float y) { this->polygon_.push_back({x, y}); }
+  // 已占用时目标离开边界超过 margin 才算离开
+  void set_margin(float margin) { this->margin_ = margin; }
+  void set_entry_delay(uint32_t delay) { this->entry_delay_ = delay; }
+  void set_exit_delay(uint32_t delay) { this->exit_delay_ = delay; }
+#ifdef USE_SENSOR
+  void set_count_sensor(sensor::Sensor *count) { this->count_sensor_ = count; }
+#endif
+#ifdef USE_BINARY_SENSOR
+  void set_occupancy_binary_sensor(binary_sensor::BinarySensor *occupancy) { this->occupancy_binary_sensor_ = occupancy; }
+#endif
+
+  void update(const LD2460Point *targets, uint8_t count, uint32_t now);
+  uint8_t get_count() const { return this->count_; }
+  void dump_config(const char *prefix) const;
+
+ protected:
+  bool contains_(const LD2460Point &p) const;
+  float edge_distance_(const LD2460Point &p) const;
+
+  std::vector<LD2460Point> polygon_;
+  float margin_{0};
+  uint32_t entry_delay_{0};
+  uint32_t exit_delay_{0};
+
+  uint8_t count_{0};          // 已发布的目标数
+  uint8_t pending_count_{0};  // 等待防抖的目标数
+  uint32_t pending_since_{0};
+  bool published_{false};
+#ifdef USE_SENSOR
+  sensor::Sensor *count_sensor_{nullptr};
+#endif
+#ifdef USE_BINARY_SENSOR
+  binary_sensor::BinarySensor *occupancy_binary_sensor_{nullptr};
+#endif
+};
+
+}  // namespace ld2460
+}  // namespace esphome
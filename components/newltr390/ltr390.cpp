@@ -10,6 +10,7 @@ static const char *const TAG = "newltr390";
 
 static const uint8_t LTR390_WAKEUP_TIME = 10;
 static const uint8_t LTR390_SETTLE_TIME = 5;
+static const uint8_t LTR390_POLL_TIME = 5;
 
 static const uint8_t LTR390_MAIN_CTRL = 0x00;
 static const uint8_t LTR390_MEAS_RATE = 0x04;
@@ -29,6 +30,13 @@ static const uint32_t MODEADDRESSES[2] = {0x0D, 0x10};
 static const float INTG_MAX = RESOLUTIONVALUE[0] * 100;
 static const int GAIN_MAX = GAINVALUES[4];
 
+// 自动量程: 超过满量程的 CLIP 认为饱和; 换档时要求预计值不超过满量程的 TARGET,
+// 计数不少于 MIN_COUNTS 的 2 倍; 计数低于 MIN_COUNTS 时加长积分
+static const float LTR390_RANGE_CLIP = 0.9f;
+static const float LTR390_RANGE_TARGET = 0.5f;
+static const uint32_t LTR390_RANGE_MIN_COUNTS = 512;
+static const uint8_t LTR390_RANGE_MAX_REARM = 2;
+
 uint32_t little_endian_bytes_to_int(const uint8_t *buffer, uint8_t num_bytes) {
   uint32_t value = 0;
 
@@ -44,22 +52,6 @@ optional<uint32_t> LTR390Component::read_sensor_data_(LTR390MODE mode) {
   const uint8_t num_bytes = 3;
   uint8_t buffer[num_bytes];
 
-  // Wait until data available
-  const uint32_t now = millis();
-  while (true) {
-    std::bitset<8> status = this->reg(LTR390_MAIN_STATUS).get();
-    bool available = status[3];
-    if (available)
-      break;
-
-    if (millis() - now > 100) {
-      ESP_LOGW(TAG, "Sensor didn't return any data, aborting");
-      return {};
-    }
-    ESP_LOGD(TAG, "Waiting for data");
-    delay(2);
-  }
-
   if (!this->read_bytes(MODEADDRESSES[mode], buffer, num_bytes)) {
     ESP_LOGW(TAG, "Reading data from sensor failed!");
     return {};
@@ -68,12 +60,7 @@ optional<uint32_t> LTR390Component::read_sensor_data_(LTR390MODE mode) {
   return little_endian_bytes_to_int(buffer, num_bytes);
 }
 
-void LTR390Component::read_als_() {
-  auto val = this->read_sensor_data_(LTR390_MODE_ALS);
-  if (!val.has_value())
-    return;
-  uint32_t als = *val;
-
+void LTR390Component::read_als_(uint32_t als) {
   if (this->light_sensor_ != nullptr) {
     float lux = ((0.6 * als) / (GAINVALUES[this->gain_als_] * RESOLUTIONVALUE[this->res_als_])) * this->wfac_;
     this->light_sensor_->publish_state(lux);
@@ -84,12 +71,7 @@ void LTR390Component::read_als_() {
   }
 }
 
-void LTR390Component::read_uvs_() {
-  auto val = this->read_sensor_data_(LTR390_MODE_UVS);
-  if (!val.has_value())
-    return;
-  uint32_t uv = *val;
-
+void LTR390Component::read_uvs_(uint32_t uv) {
   if (this->uvi_sensor_ != nullptr) {
     // Set sensitivity by linearly scaling against known value in the datasheet
     float gain_scale_uv = GAINVALUES[this->gain_uv_] / GAIN_MAX;
@@ -104,47 +86,161 @@ void LTR390Component::read_uvs_() {
   }
 }
 
-void LTR390Component::read_mode_(int mode_index) {
+int32_t LTR390Component::start_measurement_() {
+  if (this->mode_funcs_.empty()) {
+    return -1;
+  }
   // Set mode
-  LTR390MODE mode = std::get<0>(this->mode_funcs_[mode_index]);
+  LTR390MODE mode = std::get<0>(this->mode_funcs_[this->mode_index_]);
+  bool was_enabled = this->ctrl_[LTR390_CTRL_EN];
 
-  std::bitset<8> ctrl = this->reg(LTR390_MAIN_CTRL).get();
+  std::bitset<8> ctrl = this->ctrl_;
   ctrl[LTR390_CTRL_MODE] = mode;
   ctrl[LTR390_CTRL_EN] = true;
-  this->reg(LTR390_MAIN_CTRL) = ctrl.to_ulong();
+  bool changed = this->write_ctrl_(ctrl);
 
-  uint32_t int_time{0};
   // Set gain, resolution and measurement rate
-  switch (mode) {
-    case LTR390_MODE_ALS:
-      this->reg(LTR390_GAIN) = this->gain_als_;
-      this->reg(LTR390_MEAS_RATE) = RESOLUTION_SETTING[this->res_als_];
-      int_time = ((uint32_t) RESOLUTIONVALUE[this->res_als_]) * 100;
-      break;
-    case LTR390_MODE_UVS:
-      this->reg(LTR390_GAIN) = this->gain_uv_;
-      this->reg(LTR390_MEAS_RATE) = RESOLUTION_SETTING[this->res_uv_];
-      int_time = ((uint32_t) RESOLUTIONVALUE[this->res_uv_]) * 100;
-      break;
-  }
-
-  // After the sensor integration time do the following
-  this->set_timeout(int_time + LTR390_WAKEUP_TIME + LTR390_SETTLE_TIME, [this, mode_index]() {
-    // Read from the sensor
-    std::get<1>(this->mode_funcs_[mode_index])();
-
-    // If there are more modes to read then begin the next
-    // otherwise stop
-    if (mode_index + 1 < (int) this->mode_funcs_.size()) {
-      this->read_mode_(mode_index + 1);
+  LTR390GAIN gain = mode == LTR390_MODE_ALS ? this->gain_als_ : this->gain_uv_;
+  LTR390RESOLUTION res = mode == LTR390_MODE_ALS ? this->res_als_ : this->res_uv_;
+  changed |= this->write_cached_(LTR390_GAIN, gain, this->gain_reg_);
+  changed |= this->write_cached_(LTR390_MEAS_RATE, RESOLUTION_SETTING[res], this->rate_reg_);
+  uint32_t int_time = (uint32_t) (RESOLUTIONVALUE[res] * 100);
+  // 数据没准备好时每 LTR390_POLL_TIME 再查一次, 最多再等一个积分周期加余量
+  this->set_retry(LTR390_POLL_TIME, int_time / LTR390_POLL_TIME + 20);
+
+  if (!changed) {
+    // 连续模式下设置没变, 设备一直在测, 直接看数据就绪位
+    return 0;
+  }
+  // After the sensor integration time read the data
+  return int_time + (was_enabled ? 0 : LTR390_WAKEUP_TIME) + LTR390_SETTLE_TIME;
+}
+
+bool LTR390Component::write_ctrl_(std::bitset<8> ctrl) {
+  if (ctrl == this->ctrl_) {
+    return false;
+  }
+  this->reg(LTR390_MAIN_CTRL) = ctrl.to_ulong();
+  this->ctrl_ = ctrl;
+  return true;
+}
+
+bool LTR390Component::write_cached_(uint8_t reg, uint8_t value, int16_t &cache) {
+  if (cache == value) {
+    return false;
+  }
+  this->reg(reg) = value;
+  cache = value;
+  return true;
+}
+
+i2c_measure::MeasureStep LTR390Component::read_measurement_() {
+  // Wait until data available
+  std::bitset<8> status = this->reg(LTR390_MAIN_STATUS).get();
+  if (!status[3]) {
+    ESP_LOGD(TAG, "Waiting for data");
+    return i2c_measure::MEASURE_RETRY;
+  }
+
+  // Read from the sensor
+  LTR390MODE mode = std::get<0>(this->mode_funcs_[this->mode_index_]);
+  auto val = this->read_sensor_data_(mode);
+  if (val.has_value()) {
+    bool auto_range = mode == LTR390_MODE_ALS ? this->auto_range_als_ : this->auto_range_uv_;
+    LTR390GAIN &gain = mode == LTR390_MODE_ALS ? this->gain_als_ : this->gain_uv_;
+    LTR390RESOLUTION &res = mode == LTR390_MODE_ALS ? this->res_als_ : this->res_uv_;
+    LTR390GAIN next_gain = gain;
+    LTR390RESOLUTION next_res = res;
+    bool clipped = auto_range && this->auto_range_(*val, next_gain, next_res);
+    bool rearm = clipped && this->rearm_ < LTR390_RANGE_MAX_REARM;
+    if (!rearm) {
+      // 发布时换算要用这次测量实际用的档位
+      std::get<1>(this->mode_funcs_[this->mode_index_])(*val);
+    }
+    gain = next_gain;
+    res = next_res;
+    if (rearm) {
+      // 饱和的值不发布, 用新的量程马上重测这个模式
+      this->rearm_++;
+      return i2c_measure::MEASURE_NEXT;
+    }
+  }
+  this->rearm_ = 0;
+
+  // If there are more modes to read then begin the next
+  // otherwise stop
+  if (++this->mode_index_ < this->mode_funcs_.size()) {
+    return i2c_measure::MEASURE_NEXT;
+  }
+  this->mode_index_ = 0;
+  if (!this->continuous_) {
+    // put sensor in standby
+    std::bitset<8> ctrl = this->ctrl_;
+    ctrl[LTR390_CTRL_EN] = false;
+    this->write_ctrl_(ctrl);
+  }
+  return i2c_measure::MEASURE_DONE;
+}
+
+bool LTR390Component::auto_range_(uint32_t raw, LTR390GAIN &gain, LTR390RESOLUTION &res) {
+  auto full_scale = [](int r) { return (float) ((1UL << RESOLUTION_BITS[r]) - 1); };
+  auto scale = [](int g, int r) { return GAINVALUES[g] * RESOLUTIONVALUE[r]; };
+
+  bool clipped = raw >= full_scale(res) * LTR390_RANGE_CLIP;
+  bool too_dim = raw < LTR390_RANGE_MIN_COUNTS;
+  // 换算到单位增益、单位积分时间的亮度; 饱和时真实值未知, 按 4 倍估计
+  float light = raw / scale(gain, res) * (clipped ? 4 : 1);
+
+  // 合格档位: 预计不超过满量程的 TARGET, 计数不少于 MIN_COUNTS 的 2 倍
+  // 取积分时间最短的, 同样时间取增益最高的
+  int best_gain = -1;
+  int best_res = -1;
+  // 没有合格档位时: 太亮取最不容易饱和的档位, 太暗取不饱和的档位里最灵敏的
+  int dim_gain = 0;
+  int dim_res = 0;
+  int bright_gain = 0;
+  int bright_res = 0;
+  for (int r = 0; r < 6; r++) {
+    for (int g = 0; g < 5; g++) {
+      float counts = light * scale(g, r);
+      bool fits = counts <= full_scale(r) * LTR390_RANGE_TARGET;
+      if (fits && counts >= LTR390_RANGE_MIN_COUNTS * 2 &&
+          (best_gain < 0 || RESOLUTIONVALUE[r] < RESOLUTIONVALUE[best_res] ||
+           (r == best_res && g > best_gain))) {
+        best_gain = g;
+        best_res = r;
+      }
+      if (fits && scale(g, r) > scale(dim_gain, dim_res)) {
+        dim_gain = g;
+        dim_res = r;
+      }
+      if (scale(g, r) / full_scale(r) < scale(bright_gain, bright_res) / full_scale(bright_res)) {
+        bright_gain = g;
+        bright_res = r;
+      }
+    }
+  }
+  if (best_gain < 0) {
+    if (clipped) {
+      best_gain = bright_gain;
+      best_res = bright_res;
+    } else if (too_dim) {
+      best_gain = dim_gain;
+      best_res = dim_res;
     } else {
-      // put sensor in standby
-      std::bitset<8> ctrl = this->reg(LTR390_MAIN_CTRL).get();
-      ctrl[LTR390_CTRL_EN] = false;
-      this->reg(LTR390_MAIN_CTRL) = ctrl.to_ulong();
-      this->reading_ = false;
+      return false;
     }
-  });
+  } else if (!clipped && !too_dim && RESOLUTIONVALUE[best_res] >= RESOLUTIONVALUE[res]) {
+    // 当前档位可用时只为缩短积分时间换档, 阈值之间留有余量, 不会来回跳
+    return false;
+  }
+  if (best_gain != gain || best_res != res) {
+    ESP_LOGD(TAG, "Range X%.0f %u-bit -> X%.0f %u-bit (raw %" PRIu32 ")", GAINVALUES[gain], RESOLUTION_BITS[res],
+             GAINVALUES[best_gain], RESOLUTION_BITS[best_res], raw);
+    gain = (LTR390GAIN) best_gain;
+    res = (LTR390RESOLUTION) best_res;
+  }
+  return clipped;
 }
 
 void LTR390Component::setup() {
@@ -171,17 +267,16 @@ void LTR390Component::setup() {
     return;
   }
 
-  // Set sensor read state
-  this->reading_ = false;
+  this->ctrl_ = ctrl;
 
   // If we need the light sensor then add to the list
   if (this->light_sensor_ != nullptr || this->als_sensor_ != nullptr) {
-    this->mode_funcs_.emplace_back(LTR390_MODE_ALS, std::bind(&LTR390Component::read_als_, this));
+    this->mode_funcs_.emplace_back(LTR390_MODE_ALS, std::bind(&LTR390Component::read_als_, this, std::placeholders::_1));
   }
 
   // If we need the UV sensor then add to the list
   if (this->uvi_sensor_ != nullptr || this->uv_sensor_ != nullptr) {
-    this->mode_funcs_.emplace_back(LTR390_MODE_UVS, std::bind(&LTR390Component::read_uvs_, this));
+    this->mode_funcs_.emplace_back(LTR390_MODE_UVS, std::bind(&LTR390Component::read_uvs_, this, std::placeholders::_1));
   }
 }
 
@@ -191,13 +286,18 @@ void LTR390Component::dump_config() {
   ESP_LOGCONFIG(TAG, "  ALS Resolution: %u-bit", RESOLUTION_BITS[this->res_als_]);
   ESP_LOGCONFIG(TAG, "  UV Gain: X%.0f", GAINVALUES[this->gain_uv_]);
   ESP_LOGCONFIG(TAG, "  UV Resolution: %u-bit", RESOLUTION_BITS[this->res_uv_]);
+  ESP_LOGCONFIG(TAG, "  ALS Auto Range: %s", YESNO(this->auto_range_als_));
+  ESP_LOGCONFIG(TAG, "  UV Auto Range: %s", YESNO(this->auto_range_uv_));
+  ESP_LOGCONFIG(TAG, "  Continuous: %s", YESNO(this->continuous_));
 }
 
 void LTR390Component::update() {
-  if (!this->reading_ && !mode_funcs_.empty()) {
-    this->reading_ = true;
-    this->read_mode_(0);
+  if (!this->is_measuring()) {
+    // 上一轮超时放弃时从第一个模式重新开始
+    this->mode_index_ = 0;
+    this->rearm_ = 0;
   }
+  TriggeredPollingComponent::update();
 }
 
 }  // namespace ltr390
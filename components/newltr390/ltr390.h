@@ -1,11 +1,13 @@
 #pragma once
 
+#include <bitset>
 #include <tuple>
 #include <vector>
 #include "esphome/components/i2c/i2c.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/core/component.h"
 #include "esphome/core/optional.h"
+#include "esphome/components/i2c_measure/i2c_measure.h"
 
 namespace esphome {
 namespace newltr390 {
@@ -42,7 +44,7 @@ enum LTR390RESOLUTION {
   LTR390_RESOLUTION_13BIT,
 };
 
-class LTR390Component : public PollingComponent, public i2c::I2CDevice {
+class LTR390Component : public i2c_measure::TriggeredPollingComponent, public i2c::I2CDevice {
  public:
   float get_setup_priority() const override { return setup_priority::DATA; }
   void setup() override;
@@ -55,6 +57,9 @@ class LTR390Component : public PollingComponent, public i2c::I2CDevice {
   void set_uv_res_value(LTR390RESOLUTION res) { this->res_uv_ = res; }
   void set_wfac_value(float wfac) { this->wfac_ = wfac; }
   void set_sensitivity_max(uint32_t sensitivity_max) { this->sensitivity_max_ = sensitivity_max;}
+  void set_als_auto_range(bool auto_range) { this->auto_range_als_ = auto_range; }
+  void set_uv_auto_range(bool auto_range) { this->auto_range_uv_ = auto_range; }
+  void set_continuous(bool continuous) { this->continuous_ = continuous; }
 
   void set_light_sensor(sensor::Sensor *light_sensor) { this->light_sensor_ = light_sensor; }
   void set_als_sensor(sensor::Sensor *als_sensor) { this->als_sensor_ = als_sensor; }
@@ -62,17 +67,27 @@ class LTR390Component : public PollingComponent, public i2c::I2CDevice {
   void set_uv_sensor(sensor::Sensor *uv_sensor) { this->uv_sensor_ = uv_sensor; }
 
  protected:
+  // 依次测量 mode_funcs_ 里的每个模式, 每个模式是一段 触发 -> 等待积分 -> 读取
+  int32_t start_measurement_() override;
+  i2c_measure::MeasureStep read_measurement_() override;
+
   optional<uint32_t> read_sensor_data_(LTR390MODE mode);
 
-  void read_als_();
-  void read_uvs_();
+  void read_als_(uint32_t als);
+  void read_uvs_(uint32_t uv);
+
+  // 根据这次的原始计数调整下一次的增益和分辨率, 返回这次是否接近饱和
+  bool auto_range_(uint32_t raw, LTR390GAIN &gain, LTR390RESOLUTION &res);
 
-  void read_mode_(int mode_index);
+  // 寄存器只在值变化时才写, 值缓存在这里, -1 表示未知
+  bool write_ctrl_(std::bitset<8> ctrl);
+  bool write_cached_(uint8_t reg, uint8_t value, int16_t &cache);
 
-  bool reading_;
+  size_t mode_index_{0};
+  uint8_t rearm_{0};  // 本轮因为饱和重测的次数
 
   // a list of modes and corresponding read functions
-  std::vector<std::tuple<LTR390MODE, std::function<void()>>> mode_funcs_;
+  std::vector<std::tuple<LTR390MODE, std::function<void(uint32_t)>>> mode_funcs_;
 
   LTR390GAIN gain_als_;
   LTR390GAIN gain_uv_;
@@ -80,6 +95,13 @@ class LTR390Component : public PollingComponent, public i2c::I2CDevice {
   LTR390RESOLUTION res_uv_;
   float wfac_;
   uint32_t sensitivity_max_;
+  bool auto_range_als_{false};
+  bool auto_range_uv_{false};
+  // 一轮测完后不进入待机, 下一轮设置没变时不用等唤醒和积分
+  bool continuous_{false};
+  std::bitset<8> ctrl_;
+  int16_t gain_reg_{-1};
+  int16_t rate_reg_{-1};
 
   sensor::Sensor *light_sensor_{nullptr};
   sensor::Sensor *als_sensor_{nullptr};
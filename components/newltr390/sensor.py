@@ -1,5 +1,6 @@
 import esphome.codegen as cg
 from esphome.components import i2c, sensor
+from esphome.components.i2c_measure import TriggeredPollingComponent
 import esphome.config_validation as cv
 from esphome.const import (
     CONF_AMBIENT_LIGHT,
@@ -15,17 +16,20 @@ from esphome.const import (
 
 CODEOWNERS = ["@sjtrny", "@latonita"]
 DEPENDENCIES = ["i2c"]
+AUTO_LOAD = ["i2c_measure"]
 
 ltr390_ns = cg.esphome_ns.namespace("newltr390")
 
 LTR390Component = ltr390_ns.class_(
-    "LTR390Component", cg.PollingComponent, i2c.I2CDevice
+    "LTR390Component", TriggeredPollingComponent, i2c.I2CDevice
 )
 
 CONF_UV_INDEX = "uv_index"
 CONF_UV = "uv"
 CONF_WINDOW_CORRECTION_FACTOR = "window_correction_factor"
 CONF_SENSITIVITY_MAX = "sensitivity_max"
+CONF_AUTO_RANGE = "auto_range"
+CONF_CONTINUOUS = "continuous"
 
 UNIT_COUNTS = "#"
 UNIT_UVI = "UVI"
@@ -99,6 +103,18 @@ CONFIG_SCHEMA = cv.All(
                 min=1.0
             ),
             cv.Optional(CONF_SENSITIVITY_MAX, default=1400): cv.int_range(min=0, max=10000),
+            # 测完不进入待机, 设置不变时直接读下一个样本
+            cv.Optional(CONF_CONTINUOUS, default=False): cv.boolean,
+            # 按上一次的计数自动选择增益和分辨率, gain/resolution 作为起始档位
+            cv.Optional(CONF_AUTO_RANGE, default=False): cv.Any(
+                cv.boolean,
+                cv.Schema(
+                    {
+                        cv.Required(CONF_AMBIENT_LIGHT): cv.boolean,
+                        cv.Required(CONF_UV): cv.boolean,
+                    }
+                ),
+            ),
         }
     )
     .extend(cv.polling_component_schema("60s"))
@@ -121,6 +137,7 @@ async def to_code(config):
 
     cg.add(var.set_wfac_value(config[CONF_WINDOW_CORRECTION_FACTOR]))
     cg.add(var.set_sensitivity_max(config[CONF_SENSITIVITY_MAX]))
+    cg.add(var.set_continuous(config[CONF_CONTINUOUS]))
     for key, funcName in TYPES.items():
         if key in config:
             sens = await sensor.new_sensor(config[key])
@@ -141,3 +158,11 @@ async def to_code(config):
     else:
         cg.add(var.set_als_res_value(res_value))
         cg.add(var.set_uv_res_value(res_value))
+
+    auto_range = config[CONF_AUTO_RANGE]
+    if isinstance(auto_range, dict):
+        cg.add(var.set_als_auto_range(auto_range[CONF_AMBIENT_LIGHT]))
+        cg.add(var.set_uv_auto_range(auto_range[CONF_UV]))
+    else:
+        cg.add(var.set_als_auto_range(auto_range))
+        cg.add(var.set_uv_auto_range(auto_range))
@@ -1,7 +1,8 @@
 import esphome.codegen as cg
+from esphome import automation
 import esphome.config_validation as cv
 from esphome.components import uart
-from esphome.const import CONF_ID, CONF_PORT, CONF_ADDRESS
+from esphome.const import CONF_ID, CONF_PORT, CONF_ADDRESS, CONF_DATA
 
 AUTO_LOAD = ["socket", "async_tcp"]
 CODEOWNERS = ["@synodriver"]
@@ -9,16 +10,39 @@ CODEOWNERS = ["@synodriver"]
 DEPENDENCIES = ["uart", "network"]
 
 CONF_STREAM_CLIENT_ID = "stream_client_id"
+CONF_TRANSPORT = "transport"
+CONF_BATCH_SIZE = "batch_size"
+CONF_FLUSH_INTERVAL = "flush_interval"
 
 stream_client_ns = cg.esphome_ns.namespace("stream_client")
 StreamClientComponent = stream_client_ns.class_("StreamClientComponent", cg.Component, uart.UARTDevice)
 
+Transport = stream_client_ns.enum("Transport")
+TRANSPORT_OPTIONS = {
+    "tcp": Transport.TRANSPORT_TCP,
+    "udp": Transport.TRANSPORT_UDP,
+}
+
+# udp 数据报头: seq(u32 LE) + millis(u32 LE)
+UDP_HEADER_SIZE = 8
+# 以太网 MTU 1500 - IP/UDP 头 28 - 自定义头
+UDP_MAX_PAYLOAD = 1472 - UDP_HEADER_SIZE
+
 def validate_buffer_size(buffer_size):
     if buffer_size & (buffer_size - 1) != 0:
         raise cv.Invalid("Buffer size must be a power of two.")
     return buffer_size
 
 
+def validate_udp_address(config):
+    if config[CONF_TRANSPORT] == "udp":
+        try:
+            cv.ipv4address(config[CONF_ADDRESS])
+        except cv.Invalid as e:
+            raise cv.Invalid("udp transport requires an IPv4 address", path=[CONF_ADDRESS]) from e
+    return config
+
+
 CONFIG_SCHEMA = cv.All(
     cv.require_esphome_version(2025, 3, 0),
     cv.Schema(
@@ -26,6 +50,9 @@ CONFIG_SCHEMA = cv.All(
             cv.GenerateID(): cv.declare_id(StreamClientComponent),
             cv.Required(CONF_ADDRESS): cv.string,
             cv.Optional(CONF_PORT, default=6638): cv.port,
+            cv.Optional(CONF_TRANSPORT, default="tcp"): cv.one_of(*TRANSPORT_OPTIONS, lower=True),
+            cv.Optional(CONF_BATCH_SIZE, default=256): cv.int_range(min=1, max=UDP_MAX_PAYLOAD),
+            cv.Optional(CONF_FLUSH_INTERVAL, default="5ms"): cv.positive_time_period_milliseconds,
             # cv.Optional(CONF_BUFFER_SIZE, default=128): cv.All(
             #     cv.positive_int, validate_buffer_size
             # ),
@@ -33,6 +60,7 @@ CONFIG_SCHEMA = cv.All(
     )
     .extend(cv.COMPONENT_SCHEMA)
     .extend(uart.UART_DEVICE_SCHEMA),
+    validate_udp_address,
 )
 
 FINAL_VALIDATE_SCHEMA = uart.final_validate_device_schema(
@@ -47,4 +75,29 @@ async def to_code(config):
     await uart.register_uart_device(var, config)
 
     cg.add(var.set_address(config[CONF_ADDRESS]))
-    cg.add(var.set_port(config[CONF_PORT]))
\ No newline at end of file
+    cg.add(var.set_port(config[CONF_PORT]))
+    cg.add(var.set_transport(TRANSPORT_OPTIONS[config[CONF_TRANSPORT]]))
+    cg.add(var.set_batch_size(config[CONF_BATCH_SIZE]))
+    cg.add(var.set_flush_interval(config[CONF_FLUSH_INTERVAL]))
+
+
+StreamClientWriteAction = stream_client_ns.class_("StreamClientWriteAction", automation.Action)
+STREAM_CLIENT_WRITE_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.use_id(StreamClientComponent),
+        cv.Required(CONF_DATA): cv.templatable(cv.ensure_list(cv.hex_uint8_t)),
+    }
+)
+@automation.register_action(
+    "stream_client.write", StreamClientWriteAction, STREAM_CLIENT_WRITE_SCHEMA
+)
+async def stream_client_write_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    data = config[CONF_DATA]
+    if cg.is_template(data):
+        templ = await cg.templatable(data, args, cg.std_vector.template(cg.uint8))
+        cg.add(var.set_data_template(templ))
+    else:
+        cg.add(var.set_data_static(data))
+    return var
@@ -1,5 +1,7 @@
 #include "stream_client.h"
 #include "esphome/core/log.h"
+#include <algorithm>
+#include <cstring>
 
 namespace esphome {
 namespace stream_client {
@@ -8,6 +10,10 @@ static const char *const TAG = "stream_client";
 
 void StreamClientComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up stream client...");
+  if (this->transport_ == TRANSPORT_UDP) {
+    this->setup_udp_();
+    return;
+  }
   this->client_ = std::make_unique<AsyncClient>();
   this->client_->onConnect([this](void *arg, AsyncClient *client) {
     ESP_LOGI(TAG, "Connected to %s:%u", this->address_.c_str(), this->port_);
@@ -43,7 +49,105 @@ if (this->connected_binary_sensor_ != nullptr) {
   }
 }
 
+void StreamClientComponent::setup_udp_() {
+  this->udp_buffer_ = std::unique_ptr<uint8_t[]>(new uint8_t[UDP_HEADER_SIZE + UDP_MAX_PAYLOAD]);
+  this->udp_socket_ = socket::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (this->udp_socket_ == nullptr) {
+    ESP_LOGE(TAG, "Failed to create udp socket");
+    this->mark_failed();
+    return;
+  }
+  this->udp_socket_->setblocking(false);
+  struct sockaddr_storage server;
+  socklen_t server_len =
+      socket::set_sockaddr((struct sockaddr *) &server, sizeof(server), this->address_, this->port_);
+  // udp 的 connect 只是绑定默认对端, 之后可以直接 write/read
+  if (server_len == 0 || this->udp_socket_->connect((struct sockaddr *) &server, server_len) != 0) {
+    ESP_LOGE(TAG, "Failed to set udp peer %s:%u, errno %d", this->address_.c_str(), this->port_, errno);
+    this->mark_failed();
+    return;
+  }
+  ESP_LOGI(TAG, "Streaming udp datagrams to %s:%u", this->address_.c_str(), this->port_);
+#ifdef USE_BINARY_SENSOR
+  if (this->connected_binary_sensor_ != nullptr) {
+    this->connected_binary_sensor_->publish_state(true);
+  }
+#endif
+}
+
+void StreamClientComponent::loop_udp_() {
+  // 网络 -> 串口, 对端发来的数据报不带头, 原样转发
+  uint8_t rx[256];
+  ssize_t len;
+  while ((len = this->udp_socket_->read(rx, sizeof(rx))) > 0) {
+    this->write_array(rx, len);
+  }
+
+  // 串口 -> 网络, 攒够 batch_size 或者超过 flush_interval 就发一个数据报
+  size_t avail = this->available();
+  while (avail > 0) {
+    if (this->udp_len_ == 0) {
+      this->batch_start_ = millis();
+    }
+    size_t n = std::min(avail, this->batch_size_ - this->udp_len_);
+    if (!this->read_array(this->udp_buffer_.get() + UDP_HEADER_SIZE + this->udp_len_, n)) {
+      break;
+    }
+    this->udp_len_ += n;
+    avail -= n;
+    if (this->udp_len_ >= this->batch_size_) {
+      this->flush_udp_();
+    }
+  }
+  if (this->udp_len_ > 0 && millis() - this->batch_start_ >= this->flush_interval_) {
+    this->flush_udp_();
+  }
+}
+
+void StreamClientComponent::flush_udp_() {
+  uint32_t seq = this->udp_seq_++;
+  uint32_t now = millis();
+  this->udp_buffer_[0] = seq & 0xFF;
+  this->udp_buffer_[1] = (seq >> 8) & 0xFF;
+  this->udp_buffer_[2] = (seq >> 16) & 0xFF;
+  this->udp_buffer_[3] = (seq >> 24) & 0xFF;
+  this->udp_buffer_[4] = now & 0xFF;
+  this->udp_buffer_[5] = (now >> 8) & 0xFF;
+  this->udp_buffer_[6] = (now >> 16) & 0xFF;
+  this->udp_buffer_[7] = (now >> 24) & 0xFF;
+  // 发送失败直接丢弃, 序号照样递增, 对端据此统计丢包
+  if (this->udp_socket_->write(this->udp_buffer_.get(), UDP_HEADER_SIZE + this->udp_len_) < 0) {
+    ESP_LOGV(TAG, "Dropped datagram %" PRIu32 ", errno %d", seq, errno);
+  }
+  this->udp_len_ = 0;
+}
+
+void StreamClientComponent::write_data(const uint8_t *data, size_t len) {
+  if (this->udp_socket_) {
+    // 先把攒着的串口数据发出去, 再按数据报大小分片
+    if (this->udp_len_ > 0) {
+      this->flush_udp_();
+    }
+    while (len > 0) {
+      size_t n = std::min(len, UDP_MAX_PAYLOAD);
+      memcpy(this->udp_buffer_.get() + UDP_HEADER_SIZE, data, n);
+      this->udp_len_ = n;
+      this->flush_udp_();
+      data += n;
+      len -= n;
+    }
+    return;
+  }
+  if (this->client_ && this->client_->connected()) {
+    this->client_->write(reinterpret_cast<const char *>(data), len);
+  }
+}
+
 void StreamClientComponent::loop() {
+  if (this->udp_socket_) {
+    this->loop_udp_();
+    return;
+  }
   if (this->client_) {
 #if !defined(USE_ESP32) && !defined(USE_ESP8266) && !defined(USE_RP2040) && !defined(USE_LIBRETINY) && \
 (defined(USE_SOCKET_IMPL_LWIP_SOCKETS) || defined(USE_SOCKET_IMPL_BSD_SOCKETS))
@@ -60,8 +164,15 @@ void StreamClientComponent::dump_config() {
   ESP_LOGCONFIG(TAG,
               "stream client:\n "
               "  Host: %s\n "
-              "  Port: %u",
-              this->address_.c_str(), this->port_);
+              "  Port: %u\n "
+              "  Transport: %s",
+              this->address_.c_str(), this->port_, this->transport_ == TRANSPORT_UDP ? "udp" : "tcp");
+  if (this->transport_ == TRANSPORT_UDP) {
+    ESP_LOGCONFIG(TAG,
+                "  Batch Size: %zu\n "
+                "  Flush Interval: %" PRIu32 " ms",
+                this->batch_size_, this->flush_interval_);
+  }
 #ifdef USE_BINARY_SENSOR
   LOG_BINARY_SENSOR("  ", "Connected Binary Sensor", this->connected_binary_sensor_);
 #endif
@@ -2,6 +2,7 @@
 
 #include "esphome/core/defines.h"
 #include "esphome/core/component.h"
+#include "esphome/core/automation.h"
 #include "esphome/components/uart/uart.h"
 #include "esphome/components/socket/socket.h"
 #include "esphome/components/async_tcp/async_tcp.h"
@@ -12,6 +13,15 @@
 namespace esphome {
 namespace stream_client {
 
+enum Transport : uint8_t {
+  TRANSPORT_TCP,
+  TRANSPORT_UDP,
+};
+
+// udp 数据报头: 序号 + 发送时刻(millis), 小端, 后接串口数据
+static const size_t UDP_HEADER_SIZE = 8;
+static const size_t UDP_MAX_PAYLOAD = 1472 - UDP_HEADER_SIZE;
+
 class StreamClientComponent: public Component, public uart::UARTDevice {
 #ifdef USE_BINARY_SENSOR
   SUB_BINARY_SENSOR(connected)
@@ -26,14 +36,59 @@ class StreamClientComponent: public Component, public uart::UARTDevice {
     void set_address(const std::string& address) { this->address_ = address; } // some ip address or hostname
     // void set_buffer_size(size_t size) { this->buf_size_ = size; }
     void set_port(uint16_t port) { this->port_ = port; }
+    void set_transport(Transport transport) { this->transport_ = transport; }
+    void set_batch_size(size_t size) { this->batch_size_ = size; }
+    void set_flush_interval(uint32_t interval) { this->flush_interval_ = interval; }
+    // 由其他组件直接发送数据, 不经过串口
+    void write_data(const uint8_t *data, size_t len);
 
   protected:
     std::string address_;
     // size_t buf_size_{};
     uint16_t port_{};
 
+    Transport transport_{TRANSPORT_TCP};
+
     std::unique_ptr<AsyncClient> client_{};
 
+    void setup_udp_();
+    void loop_udp_();
+    void flush_udp_();
+
+    std::unique_ptr<socket::Socket> udp_socket_{};
+    size_t batch_size_{256};
+    uint32_t flush_interval_{5};
+    uint32_t udp_seq_{0};
+    uint32_t batch_start_{0};  // 本批第一个字节到达时刻
+    size_t udp_len_{0};         // 已缓存的payload长度
+    std::unique_ptr<uint8_t[]> udp_buffer_{};  // 只有 udp 模式才分配, 报头 + UDP_MAX_PAYLOAD
+
+};
+
+template<typename... Ts> class StreamClientWriteAction : public Action<Ts...>, public Parented<StreamClientComponent> {
+ public:
+  void set_data_template(std::function<std::vector<uint8_t>(Ts...)> func) {
+    this->data_func_ = func;
+    this->static_ = false;
+  }
+  void set_data_static(const std::vector<uint8_t> &data) {
+    this->data_static_ = data;
+    this->static_ = true;
+  }
+
+  void play(const Ts &...x) override {
+    if (this->static_) {
+      this->parent_->write_data(this->data_static_.data(), this->data_static_.size());
+    } else {
+      auto val = this->data_func_(x...);
+      this->parent_->write_data(val.data(), val.size());
+    }
+  }
+
+ protected:
+  bool static_{false};
+  std::function<std::vector<uint8_t>(Ts...)> data_func_{};
+  std::vector<uint8_t> data_static_{};
 };
 
 }
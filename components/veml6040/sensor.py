@@ -2,18 +2,23 @@ from esphome import automation
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import sensor, i2c
+from esphome.components.i2c_measure import TriggeredPollingComponent
 from esphome.const import (
     CONF_ID, CONF_RED, CONF_GREEN, CONF_BLUE, CONF_WHITE, CONF_INTEGRATION_TIME, CONF_MODE,
-    ICON_BRIGHTNESS_5, UNIT_LUX, DEVICE_CLASS_ILLUMINANCE
+    CONF_ILLUMINANCE, CONF_COLOR_TEMPERATURE,
+    ICON_BRIGHTNESS_5, ICON_THERMOMETER, UNIT_LUX, UNIT_KELVIN, DEVICE_CLASS_ILLUMINANCE,
+    STATE_CLASS_MEASUREMENT,
 )
 
 CODEOWNERS = ["@synodriver"]
 DEPENDENCIES = ["i2c"]
+AUTO_LOAD = ["i2c_measure"]
 
 CONF_TRIGGER = "trigger"
+CONF_AUTO_INTEGRATION = "auto_integration"
 
 veml6040 = cg.esphome_ns.namespace("veml6040")
-VEML6040Component = veml6040.class_("VEML6040Component", cg.PollingComponent, i2c.I2CDevice)
+VEML6040Component = veml6040.class_("VEML6040Component", TriggeredPollingComponent, i2c.I2CDevice)
 
 VEML6040_INTEGRATION_TIME = veml6040.enum("VEML6040_INTEGRATION_TIME")
 VEML6040_INTEGRATION_TIME_OPTIONS = {
@@ -59,7 +64,22 @@ CONFIG_SCHEMA = cv.All(
                 accuracy_decimals=1,
                 device_class=DEVICE_CLASS_ILLUMINANCE,
             ),
+            cv.Optional(CONF_ILLUMINANCE): sensor.sensor_schema(
+                unit_of_measurement=UNIT_LUX,
+                icon=ICON_BRIGHTNESS_5,
+                accuracy_decimals=1,
+                device_class=DEVICE_CLASS_ILLUMINANCE,
+                state_class=STATE_CLASS_MEASUREMENT,
+            ),
+            cv.Optional(CONF_COLOR_TEMPERATURE): sensor.sensor_schema(
+                unit_of_measurement=UNIT_KELVIN,
+                icon=ICON_THERMOMETER,
+                accuracy_decimals=0,
+                state_class=STATE_CLASS_MEASUREMENT,
+            ),
             cv.Optional(CONF_INTEGRATION_TIME, default="80ms"): cv.enum(VEML6040_INTEGRATION_TIME_OPTIONS),
+            # 按 G/W 通道的计数在 40ms~1280ms 之间自动切换积分时间, 原始计数换算成 40ms 下的计数
+            cv.Optional(CONF_AUTO_INTEGRATION, default=False): cv.boolean,
             cv.Optional(CONF_TRIGGER, default=False): cv.boolean,
             cv.Optional(CONF_MODE, default="auto"): cv.enum(VEML6040_MODE_OPTIONS),
 
@@ -89,9 +109,16 @@ async def to_code(config):
     if CONF_WHITE in config:
         sens = await sensor.new_sensor(config[CONF_WHITE])
         cg.add(var.set_white_sensor(sens))
+    if CONF_ILLUMINANCE in config:
+        sens = await sensor.new_sensor(config[CONF_ILLUMINANCE])
+        cg.add(var.set_illuminance_sensor(sens))
+    if CONF_COLOR_TEMPERATURE in config:
+        sens = await sensor.new_sensor(config[CONF_COLOR_TEMPERATURE])
+        cg.add(var.set_color_temperature_sensor(sens))
     cg.add(var.set_integration_time(config[CONF_INTEGRATION_TIME]))
     cg.add(var.set_trig(config[CONF_TRIGGER]))
     cg.add(var.set_mode(config[CONF_MODE]))
+    cg.add(var.set_auto_integration(config[CONF_AUTO_INTEGRATION]))
 
 
 VEML6040ShutdownAction = veml6040.class_("VEML6040ShutdownAction", automation.Action)
@@ -1,5 +1,7 @@
 #include "veml6040.h"
+#include <algorithm>
 #include <bitset>
+#include <cmath>
 #include "esphome/components/i2c/i2c.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
@@ -14,6 +16,14 @@ static const uint8_t REG_GREEN = 0x09;
 static const uint8_t REG_BLUE = 0x0A;
 static const uint8_t REG_WHITE = 0x0B;
 
+// 40ms 积分时间下 G 通道每个计数对应的 lux, 积分时间每翻倍灵敏度翻倍
+static const float VEML6040_LUX_PER_COUNT_40MS = 0.25168f;
+// 自动积分时间: 16 位计数超过 CLIP 认为饱和, 积分时间翻倍后预计不超过 TARGET 才加长
+static const uint16_t VEML6040_RANGE_FULL = 0xFFFF;
+static const float VEML6040_RANGE_CLIP = 0.9f;
+static const float VEML6040_RANGE_TARGET = 0.45f;
+static const uint8_t VEML6040_RANGE_MAX_REARM = 2;
+
 void VEML6040Component::setup() {
   ESP_LOGCONFIG(TAG, "Running setup");
   this->write_config(this->integration_time_, this->trig_, this->mode_, false);  // Normal operation
@@ -21,11 +31,14 @@ void VEML6040Component::setup() {
 
 void VEML6040Component::dump_config() {
   ESP_LOGCONFIG(TAG, "VEML6040:");
+  ESP_LOGCONFIG(TAG, "  Auto Integration: %s", YESNO(this->auto_integration_));
   LOG_I2C_DEVICE(this);
   LOG_SENSOR("  ", "Red Sensor", this->red_sensor_);
   LOG_SENSOR("  ", "Green Sensor", this->green_sensor_);
   LOG_SENSOR("  ", "Blue Sensor", this->blue_sensor_);
   LOG_SENSOR("  ", "White Sensor", this->white_sensor_);
+  LOG_SENSOR("  ", "Illuminance Sensor", this->illuminance_sensor_);
+  LOG_SENSOR("  ", "Color Temperature Sensor", this->color_temperature_sensor_);
 }
 
 void VEML6040Component::shutdown() {
@@ -36,7 +49,7 @@ void VEML6040Component::wakeup() {
   this->write_config(this->integration_time_, this->trig_, this->mode_, false);  // Normal operation
 }
 
-void VEML6040Component::write_config(VEML6040_INTEGRATION_TIME time, bool trig, VEML6040_MODE mode, bool shutdown) {
+i2c::ErrorCode VEML6040Component::write_config(VEML6040_INTEGRATION_TIME time, bool trig, VEML6040_MODE mode, bool shutdown) {
   std::bitset<8> config;
   switch (time) {
     case VEML6040_INTEGRATION_TIME_40MS:
@@ -85,45 +98,125 @@ void VEML6040Component::write_config(VEML6040_INTEGRATION_TIME time, bool trig,
   } else {
     config[0] = false;  // Normal operation
   }
-  this->send_word(REG_CONF, config.to_ulong());
+  return this->send_word(REG_CONF, config.to_ulong());
 }
 
-void VEML6040Component::send_word(uint8_t command, uint16_t data) {
+i2c::ErrorCode VEML6040Component::send_word(uint8_t command, uint16_t data) {
   uint8_t buffer[3] = {command, (uint8_t)(data & 0xFF), (uint8_t)((data >> 8) & 0xFF)};
-  this->write(buffer, 3);
+  return this->write(buffer, 3);
 }
 
 uint16_t VEML6040Component::receive_word(uint8_t command) {
+  uint16_t value = 0;
+  this->receive_word(command, &value);
+  return value;
+}
+
+bool VEML6040Component::receive_word(uint8_t command, uint16_t *value) {
   uint8_t data[2];
-  this->write_read(&command, 1, data, 2);
+  if (this->write_read(&command, 1, data, 2) != i2c::ERROR_OK) {
+    return false;
+  }
 //  this->write(&command, 1, false);  // Write the command
 //  this->read(data, 2);
-  uint16_t raw = (uint16_t)data[0] | (((uint16_t)data[1]) << 8);  // Combine the two bytes into a single word
-  return raw;
+  *value = (uint16_t)data[0] | (((uint16_t)data[1]) << 8);  // Combine the two bytes into a single word
+  return true;
 }
 
-void VEML6040Component::update() {
-  if(this->mode_ == VEML6040_MODE_FORCE) {
-    this->write_config(this->integration_time_, 1, this->mode_, false);  // Trigger a measurement
+int32_t VEML6040Component::start_measurement_() {
+  // 积分时间 40ms << time, 多等 10%
+  int32_t wait = (40 << this->integration_time_) * 11 / 10;
+  if (this->mode_ == VEML6040_MODE_FORCE) {
+    // Trigger a measurement, 积分时间跟着触发命令一起写入
+    if (this->write_config(this->integration_time_, true, this->mode_, false) != i2c::ERROR_OK) {
+      ESP_LOGW(TAG, "VEML6040 trigger failed");
+      this->status_set_warning();
+      return -1;
+    }
+    return wait;
+  }
+  if (this->range_changed_) {
+    // 自动模式换了积分时间, 等新积分时间的第一个结果
+    this->range_changed_ = false;
+    this->write_config(this->integration_time_, this->trig_, this->mode_, false);
+    return wait * 2;
   }
+  return 0;  // 自动模式, 直接读最近一次结果
+}
+
+i2c_measure::MeasureStep VEML6040Component::read_measurement_() {
+  // 四个通道先全部读出来, 再用同一组值计算
+  uint16_t red, green, blue, white;
+  if (!this->receive_word(REG_RED, &red) || !this->receive_word(REG_GREEN, &green) ||
+      !this->receive_word(REG_BLUE, &blue) || !this->receive_word(REG_WHITE, &white)) {
+    ESP_LOGW(TAG, "VEML6040 read failed");
+    this->status_set_warning();
+    return i2c_measure::MEASURE_DONE;
+  }
+  this->status_clear_warning();
+
+  // 按这次测量用的积分时间换算, 放在 auto_integration_step_ 之前
+  uint8_t time = this->integration_time_;
+  float scale = 1.0f;
+  if (this->auto_integration_) {
+    bool clipped = this->auto_integration_step_(std::max(green, white));
+    if (clipped && this->rearm_ < VEML6040_RANGE_MAX_REARM) {
+      // 饱和的值不发布, 用新的积分时间马上重测
+      this->rearm_++;
+      return i2c_measure::MEASURE_NEXT;
+    }
+    // 积分时间会变, 原始计数统一换算成 40ms 下的计数
+    scale = 1.0f / (1 << time);
+  }
+  this->rearm_ = 0;
+
   if (this->red_sensor_ != nullptr) {
-    uint16_t red = this->receive_word(REG_RED);
-    this->red_sensor_->publish_state(red);
+    this->red_sensor_->publish_state(red * scale);
   }
   if (this->green_sensor_ != nullptr) {
-    uint16_t green = this->receive_word(REG_GREEN);
-    this->green_sensor_->publish_state(green);
+    this->green_sensor_->publish_state(green * scale);
   }
   if (this->blue_sensor_ != nullptr) {
-    uint16_t blue = this->receive_word(REG_BLUE);
-    this->blue_sensor_->publish_state(blue);
+    this->blue_sensor_->publish_state(blue * scale);
   }
   if (this->white_sensor_ != nullptr) {
-    uint16_t white = this->receive_word(REG_WHITE);
-    this->white_sensor_->publish_state(white);
+    this->white_sensor_->publish_state(white * scale);
+  }
+  if (this->illuminance_sensor_ != nullptr) {
+    this->illuminance_sensor_->publish_state(green * VEML6040_LUX_PER_COUNT_40MS / (1 << time));
+  }
+  if (this->color_temperature_sensor_ != nullptr) {
+    // Vishay 应用笔记的经验公式, 和积分时间无关; 太暗或者偏色算不出来时发布 NAN
+    float cct = NAN;
+    if (green > 0) {
+      float ccti = ((float) red - (float) blue) / green + 0.5f;
+      if (ccti > 0) {
+        cct = 4278.6f * powf(ccti, -1.2455f);
+      }
+    }
+    this->color_temperature_sensor_->publish_state(cct);
   }
+  return i2c_measure::MEASURE_DONE;
 }
 
-
+bool VEML6040Component::auto_integration_step_(uint16_t peak) {
+  // 40ms 到 1280ms 每一档灵敏度翻倍
+  int level = this->integration_time_;
+  bool clipped = peak >= VEML6040_RANGE_FULL * VEML6040_RANGE_CLIP;
+  int next = level;
+  if (clipped) {
+    next = std::max(level - (peak == VEML6040_RANGE_FULL ? 2 : 1), 0);
+  } else if (peak * 2 < VEML6040_RANGE_FULL * VEML6040_RANGE_TARGET) {
+    // 加长一档后仍不超过 TARGET, 和 CLIP 之间留出余量不会来回跳
+    next = std::min(level + 1, (int) VEML6040_INTEGRATION_TIME_1280MS);
+  }
+  if (next != level) {
+    this->integration_time_ = (VEML6040_INTEGRATION_TIME) next;
+    this->range_changed_ = true;
+    ESP_LOGD(TAG, "Integration time %dms (peak %u)", 40 << next, peak);
+  }
+  return clipped;
 }
-}
\ No newline at end of file
+
+}  // namespace veml6040
+}  // namespace esphome
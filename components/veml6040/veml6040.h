@@ -6,6 +6,7 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
+#include "esphome/components/i2c_measure/i2c_measure.h"
 
 namespace esphome {
 namespace veml6040 {
@@ -24,36 +25,51 @@ enum VEML6040_MODE: uint8_t {
   VEML6040_MODE_FORCE,
 };
 
-class VEML6040Component : public PollingComponent, public i2c::I2CDevice {
+class VEML6040Component : public i2c_measure::TriggeredPollingComponent, public i2c::I2CDevice {
  public:
   void setup() override;
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
-  void update() override;
 
   void set_red_sensor(sensor::Sensor *red_sensor) { this->red_sensor_ = red_sensor; }
   void set_green_sensor(sensor::Sensor *green_sensor) { this->green_sensor_ = green_sensor; }
   void set_blue_sensor(sensor::Sensor *blue_sensor) { this->blue_sensor_ = blue_sensor; }
   void set_white_sensor(sensor::Sensor *white_sensor) { this->white_sensor_ = white_sensor; }
+  void set_illuminance_sensor(sensor::Sensor *illuminance_sensor) { this->illuminance_sensor_ = illuminance_sensor; }
+  void set_color_temperature_sensor(sensor::Sensor *color_temperature_sensor) {
+    this->color_temperature_sensor_ = color_temperature_sensor;
+  }
   void set_integration_time(VEML6040_INTEGRATION_TIME time) {
     this->integration_time_ = time;
   }
   void set_trig(bool trig) {this->trig_ = trig; }
   void set_mode(VEML6040_MODE mode) { this->mode_ = mode; }
+  void set_auto_integration(bool auto_integration) { this->auto_integration_ = auto_integration; }
   void wakeup();
   void shutdown();
  protected:
+  int32_t start_measurement_() override;
+  i2c_measure::MeasureStep read_measurement_() override;
+  // 按 G/W 里较大的计数切换积分时间, 返回这次是否饱和
+  bool auto_integration_step_(uint16_t peak);
+
   sensor::Sensor *red_sensor_{nullptr};
   sensor::Sensor *green_sensor_{nullptr};
   sensor::Sensor *blue_sensor_{nullptr};
   sensor::Sensor *white_sensor_{nullptr};
+  sensor::Sensor *illuminance_sensor_{nullptr};
+  sensor::Sensor *color_temperature_sensor_{nullptr};
   VEML6040_INTEGRATION_TIME integration_time_;
   bool trig_;
   VEML6040_MODE mode_;
+  bool auto_integration_{false};
+  bool range_changed_{false};
+  uint8_t rearm_{0};
 
-  void write_config(VEML6040_INTEGRATION_TIME time, bool trig, VEML6040_MODE mode, bool shutdown);
-  void send_word(uint8_t command, uint16_t data);
+  i2c::ErrorCode write_config(VEML6040_INTEGRATION_TIME time, bool trig, VEML6040_MODE mode, bool shutdown);
+  i2c::ErrorCode send_word(uint8_t command, uint16_t data);
   uint16_t receive_word(uint8_t command);
+  bool receive_word(uint8_t command, uint16_t *value);
 };
 
 template<typename... Ts> class VEML6040ShutdownAction : public Action<Ts...> {
@@ -2,15 +2,17 @@ from esphome import automation
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import sensor, i2c
+from esphome.components.i2c_measure import TriggeredPollingComponent
 from esphome.const import (
     CONF_ID, CONF_INTEGRATION_TIME, ICON_BRIGHTNESS_5, DEVICE_CLASS_EMPTY
 )
 
 CODEOWNERS = ["@synodriver"]
 DEPENDENCIES = ["i2c"]
+AUTO_LOAD = ["i2c_measure"]
 
 veml6075 = cg.esphome_ns.namespace("veml6075")
-VEML6075Component = veml6075.class_("VEML6075Component", cg.PollingComponent, i2c.I2CDevice)
+VEML6075Component = veml6075.class_("VEML6075Component", TriggeredPollingComponent, i2c.I2CDevice)
 
 UNIT_COUNTS = "#"
 UNIT_UVI = "UVI"
@@ -23,6 +25,7 @@ CONF_UV_COMP2 = "UV_COMP2"
 CONF_DYNAMIC_SETTING = "dynamic_setting"
 CONF_TRIGGER = "trigger"
 CONF_ACTIVE_FORCE_MODE = "active_force_mode"
+CONF_AUTO_RANGE = "auto_range"
 
 VEML6075IntegrationTime = veml6075.enum("VEML6075IntegrationTime")
 VEML6075IntegrationTimeOptions = {
@@ -59,6 +62,8 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_DYNAMIC_SETTING, default="high"): cv.enum(VEML6075DynamicSettingOptions),
             # cv.Optional(CONF_TRIGGER, default=0): cv.enum(VEML6075TriggerOptions),
             cv.Optional(CONF_ACTIVE_FORCE_MODE, default="enable"): cv.enum(VEML6075ActiveForceModeOptions),
+            # 按饱和程度自动切换积分时间和高动态, 发布值换算成 100ms 普通动态范围下的计数
+            cv.Optional(CONF_AUTO_RANGE, default=False): cv.boolean,
 
             cv.Optional(CONF_UVA): sensor.sensor_schema(
                 unit_of_measurement=UNIT_COUNTS,
@@ -93,6 +98,7 @@ async def to_code(config):
     cg.add(var.set_it(config[CONF_INTEGRATION_TIME]))
     cg.add(var.set_dynamic_setting(config[CONF_DYNAMIC_SETTING]))
     cg.add(var.set_active_force_mode(config[CONF_ACTIVE_FORCE_MODE]))
+    cg.add(var.set_auto_range(config[CONF_AUTO_RANGE]))
     if CONF_UVA in config:
         sens = await sensor.new_sensor(config[CONF_UVA])
         cg.add(var.set_uva_sensor(sens))
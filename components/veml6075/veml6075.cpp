@@ -1,4 +1,5 @@
 #include "veml6075.h"
+#include <algorithm>
 #include <bitset>
 #include "esphome/components/i2c/i2c.h"
 #include "esphome/core/hal.h"
@@ -15,6 +16,12 @@ static const uint8_t REG_UVCOMP1 = 0x0A;
 static const uint8_t REG_UVCOMP2 = 0x0B;
 static const uint8_t REG_ID = 0x0C;  // Device ID register
 
+// 自动量程: 16 位计数超过 CLIP 认为饱和, 升档后预计不超过 TARGET 才升档
+static const uint16_t VEML6075_RANGE_FULL = 0xFFFF;
+static const float VEML6075_RANGE_CLIP = 0.9f;
+static const float VEML6075_RANGE_TARGET = 0.45f;
+static const uint8_t VEML6075_RANGE_MAX_REARM = 2;
+
 void VEML6075Component::setup() {
   this->write_config(this->time_, this->dsetting_, VEML6075_TRIGGER_NONE, this->force_mode_);
   this->set_coefficients();
@@ -22,50 +29,75 @@ void VEML6075Component::setup() {
 
 void VEML6075Component::dump_config() {
   ESP_LOGCONFIG(TAG, "VEML6075:\n"
-                     "  DEVICE ID: 0x%02X\n", this->read_id());
+                     "  DEVICE ID: 0x%02X\n"
+                     "  Auto Range: %s", this->read_id(), YESNO(this->auto_range_));
   LOG_I2C_DEVICE(this);
   LOG_SENSOR("  ", "UVA Sensor", this->uva_sensor_);
   LOG_SENSOR("  ", "UVB Sensor", this->uvb_sensor_);
   LOG_SENSOR("  ", "UVI Sensor", this->uvi_sensor_);
 }
 
-void VEML6075Component::update() {
-  VEML6075IntegrationTime time;
-  VEML6075DynamicSetting dsetting;
-  VEML6075Trigger trigger;
-  VEML6075ActiveForceMode force_mode;
-  this->read_config(&time, &dsetting, &trigger, &force_mode);
-  if(force_mode==VEML6075_ACTIVE_FORCE_MODE_ENABLE) {
-    // trigger one reading
-    this->write_config(time, dsetting, VEML6075_TRIGGER_ONCE, force_mode);
-    switch (time) {
-      case VEML6075_IT_50MS:
-        delay(50*1.1);
-        break;
-      case VEML6075_IT_100MS:
-        delay(50*1.1);
-        break;
-      case VEML6075_IT_200MS:
-        delay(50*1.1);
-        break;
-      case VEML6075_IT_400MS:
-        delay(50*1.1);
-        break;
-      case VEML6075_IT_800MS:
-        delay(50*1.1);
-        break;
+int32_t VEML6075Component::start_measurement_() {
+  // 积分时间 50ms << time, 多等 10%
+  int32_t wait = (50 << this->time_) * 11 / 10;
+  if (this->force_mode_ == VEML6075_ACTIVE_FORCE_MODE_ENABLE) {
+    // trigger one reading, 量程跟着触发命令一起写入
+    if (this->write_config(this->time_, this->dsetting_, VEML6075_TRIGGER_ONCE, this->force_mode_) != i2c::ERROR_OK) {
+      ESP_LOGW(TAG, "VEML6075 trigger failed");
+      this->status_set_warning();
+      return -1;
+    }
+    return wait;
+  }
+  if (this->range_changed_) {
+    // 连续模式换了量程, 等新量程的第一个结果
+    this->range_changed_ = false;
+    this->write_config(this->time_, this->dsetting_, VEML6075_TRIGGER_NONE, this->force_mode_);
+    return wait * 2;
+  }
+  return 0;  // 连续模式, 直接读最近一次结果
+}
+
+i2c_measure::MeasureStep VEML6075Component::read_measurement_() {
+  if (this->force_mode_ == VEML6075_ACTIVE_FORCE_MODE_ENABLE) {
+    // 触发位在单次测量完成后自动清零
+    uint16_t conf;
+    if (this->read_data(REG_UV_CONF, &conf) && (conf & 0x04)) {
+      return i2c_measure::MEASURE_RETRY;
+    }
+  }
+  // 四个通道先全部读出来, 再用同一组值计算
+  uint16_t uva, uvb, uvcomp1, uvcomp2;
+  if (!this->read_data(REG_UVA, &uva) || !this->read_data(REG_UVB, &uvb) ||
+      !this->read_data(REG_UVCOMP1, &uvcomp1) || !this->read_data(REG_UVCOMP2, &uvcomp2)) {
+    ESP_LOGW(TAG, "VEML6075 read failed");
+    this->status_set_warning();
+    return i2c_measure::MEASURE_DONE;
+  }
+  this->status_clear_warning();
+
+  // 按这次测量用的量程换算, auto_range 时统一换算成 100ms 普通动态范围下的计数
+  float scale = 1.0f;
+  if (this->auto_range_) {
+    scale = 2.0f / (1 << this->time_);
+    if (this->dsetting_ == VEML6075_HIGH_DYNAMIC) {
+      scale *= 2;
+    }
+    uint16_t peak = std::max(std::max(uva, uvb), std::max(uvcomp1, uvcomp2));
+    bool clipped = this->auto_range_step_(peak);
+    if (clipped && this->rearm_ < VEML6075_RANGE_MAX_REARM) {
+      // 饱和的值不发布, 用新的量程马上重测
+      this->rearm_++;
+      return i2c_measure::MEASURE_NEXT;
     }
   }
-  uint16_t uva = this->read_uva();
-  uint16_t uvb = this->read_uvb();
-  uint16_t uvcomp1 = this->read_comp1();
-  uint16_t uvcomp2 = this->read_comp2();
+  this->rearm_ = 0;
 
-  float _uva_calc = uva - (this->_uva_a * uvcomp1) - (this->_uva_b * uvcomp2);
+  float _uva_calc = (uva - (this->_uva_a * uvcomp1) - (this->_uva_b * uvcomp2)) * scale;
   if (this->uva_sensor_ != nullptr) {
     this->uva_sensor_->publish_state(_uva_calc);
   }
-  float _uvb_calc = uvb - (this->_uvb_c * uvcomp1) - (this->_uvb_d * uvcomp2);
+  float _uvb_calc = (uvb - (this->_uvb_c * uvcomp1) - (this->_uvb_d * uvcomp2)) * scale;
   if (this->uvb_sensor_ != nullptr) {
     this->uvb_sensor_->publish_state(_uvb_calc);
   }
@@ -73,6 +105,29 @@ void VEML6075Component::update() {
   if (this->uvi_sensor_ != nullptr) {
     this->uvi_sensor_->publish_state(uvi);
   }
+  return i2c_measure::MEASURE_DONE;
+}
+
+bool VEML6075Component::auto_range_step_(uint16_t peak) {
+  // 量程从低到高: 50ms 高动态, 50ms, 100ms, 200ms, 400ms, 800ms, 每一档灵敏度翻倍
+  // 高动态灵敏度减半, 积分时间 n 开高动态和低一档的普通动态相同, 切换后只在 50ms 用高动态
+  int level = this->time_ + (this->dsetting_ == VEML6075_HIGH_DYNAMIC ? 0 : 1);
+  bool clipped = peak >= VEML6075_RANGE_FULL * VEML6075_RANGE_CLIP;
+  int next = level;
+  if (clipped) {
+    next = std::max(level - (peak == VEML6075_RANGE_FULL ? 2 : 1), 0);
+  } else if (peak * 2 < VEML6075_RANGE_FULL * VEML6075_RANGE_TARGET) {
+    // 升一档后仍不超过 TARGET, 和 CLIP 之间留出余量不会来回跳
+    next = std::min(level + 1, 5);
+  }
+  if (next != level) {
+    this->time_ = (VEML6075IntegrationTime) (next == 0 ? 0 : next - 1);
+    this->dsetting_ = next == 0 ? VEML6075_HIGH_DYNAMIC : VEML6075_NORMAL_DYNAMIC;
+    this->range_changed_ = true;
+    ESP_LOGD(TAG, "Range %dms%s (peak %u)", 50 << this->time_,
+             this->dsetting_ == VEML6075_HIGH_DYNAMIC ? " high dynamic" : "", peak);
+  }
+  return clipped;
 }
 
 void VEML6075Component::set_coefficients(float UVA_A,
@@ -121,8 +176,8 @@ void VEML6075Component::read_config(VEML6075IntegrationTime *time, VEML6075Dynam
   }
 }
 
-void VEML6075Component::write_config(VEML6075IntegrationTime time, VEML6075DynamicSetting dsetting,
-                                     VEML6075Trigger trigger, VEML6075ActiveForceMode force_mode) {
+i2c::ErrorCode VEML6075Component::write_config(VEML6075IntegrationTime time, VEML6075DynamicSetting dsetting,
+                                               VEML6075Trigger trigger, VEML6075ActiveForceMode force_mode) {
   std::bitset<8> config;
   switch (time) {
     case VEML6075_IT_50MS:
@@ -177,7 +232,7 @@ void VEML6075Component::write_config(VEML6075IntegrationTime time, VEML6075Dynam
   }
   // ignore sd, aka power on/shut down
   uint16_t data = (uint16_t) config.to_ulong();
-  this->send_command(REG_UV_CONF, data);
+  return this->send_command(REG_UV_CONF, data);
 }
 
 uint16_t VEML6075Component::read_uva() { return this->read_data(REG_UVA); }
@@ -196,11 +251,20 @@ i2c::ErrorCode VEML6075Component::send_command(uint8_t command, uint16_t data) {
 }
 
 uint16_t VEML6075Component::read_data(uint8_t command) {
+  uint16_t value = 0;
+  this->read_data(command, &value);
+  return value;
+}
+
+bool VEML6075Component::read_data(uint8_t command, uint16_t *value) {
   uint8_t data[2];
-  this->write_read(&command, 1, data, 2);
+  if (this->write_read(&command, 1, data, 2) != i2c::ERROR_OK) {
+    return false;
+  }
 //  this->write(&command, 1, false);  // 发送命令
 //  this->read(data, 2);                                    // 读取2字节数据
-  return ((uint16_t) data[0]) | ((uint16_t) data[1]) << 8;  // 返回
+  *value = ((uint16_t) data[0]) | ((uint16_t) data[1]) << 8;
+  return true;
 }
 
 }  // namespace veml6075
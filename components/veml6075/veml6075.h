@@ -6,6 +6,7 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
+#include "esphome/components/i2c_measure/i2c_measure.h"
 
 namespace esphome {
 namespace veml6075 {
@@ -40,12 +41,11 @@ enum VEML6075ActiveForceMode : uint8_t {
   VEML6075_ACTIVE_FORCE_MODE_ENABLE,
 };
 
-class VEML6075Component : public PollingComponent, public i2c::I2CDevice {
+class VEML6075Component : public i2c_measure::TriggeredPollingComponent, public i2c::I2CDevice {
  public:
   float get_setup_priority() const override { return setup_priority::DATA; }
   void setup() override;
   void dump_config() override;
-  void update() override;
 
   void set_uva_sensor(sensor::Sensor *uva_sensor) { this->uva_sensor_ = uva_sensor; }
   void set_uvb_sensor(sensor::Sensor *uvb_sensor) { this->uvb_sensor_ = uvb_sensor; }
@@ -57,19 +57,28 @@ class VEML6075Component : public PollingComponent, public i2c::I2CDevice {
   void set_it(VEML6075IntegrationTime time) { this->time_ = time; }
   void set_dynamic_setting(VEML6075DynamicSetting dsetting) { this->dsetting_ = dsetting; }
   void set_active_force_mode(VEML6075ActiveForceMode force_mode) { this->force_mode_ = force_mode; }
+  void set_auto_range(bool auto_range) { this->auto_range_ = auto_range; }
 
  protected:
+  int32_t start_measurement_() override;
+  i2c_measure::MeasureStep read_measurement_() override;
+
   sensor::Sensor *uva_sensor_{nullptr};
   sensor::Sensor *uvb_sensor_{nullptr};
   sensor::Sensor *uvi_sensor_{nullptr};
   VEML6075IntegrationTime time_;
   VEML6075DynamicSetting dsetting_;
   VEML6075ActiveForceMode force_mode_;
+  // 按 UVA/UVB/COMP 里最大的计数切换积分时间和高动态, 返回这次是否饱和
+  bool auto_range_step_(uint16_t peak);
+  bool auto_range_{false};
+  bool range_changed_{false};
+  uint8_t rearm_{0};
 
   void read_config(VEML6075IntegrationTime *time, VEML6075DynamicSetting *dsetting, VEML6075Trigger *trigger,
                    VEML6075ActiveForceMode *force_mode);
-  void write_config(VEML6075IntegrationTime time, VEML6075DynamicSetting dsetting, VEML6075Trigger trigger,
-                    VEML6075ActiveForceMode force_mode);
+  i2c::ErrorCode write_config(VEML6075IntegrationTime time, VEML6075DynamicSetting dsetting, VEML6075Trigger trigger,
+                              VEML6075ActiveForceMode force_mode);
   uint16_t read_uva();
   uint16_t read_uvb();
   uint16_t read_comp1();
@@ -77,6 +86,7 @@ class VEML6075Component : public PollingComponent, public i2c::I2CDevice {
   uint16_t read_id();
   i2c::ErrorCode send_command(uint8_t command, uint16_t data);
   uint16_t read_data(uint8_t command);
+  bool read_data(uint8_t command, uint16_t *value);
 
   float _uva_a;
   float _uva_b;
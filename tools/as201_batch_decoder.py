@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+"""
+把 as201 export 导出的二进制批量数据解码成 csv
+
+    python3 tools/stream_client_udp_receiver.py --output imu.bin
+    python3 tools/as201_batch_decoder.py imu.bin > imu.csv
+
+格式(小端):
+    头: 'A' 'S' version(u8) count(u8) counter(u16) timestamp(u32 ms)
+    采样: dt(u16 ms) + 数据帧第 5~46 字节(int16 x 17, int32 x 2)
+"""
+import argparse
+import struct
+import sys
+
+HEADER = struct.Struct("<2sBBHI")
+SAMPLE = struct.Struct("<H3h3h3H3h4hhii")
+VERSION = 1
+
+# 与 as201.cpp decode_sample_ 中的比例一致
+COLUMNS = [
+    ("accel_x", 0.00478515625), ("accel_y", 0.00478515625), ("accel_z", 0.00478515625),
+    ("gyro_x", 0.0625), ("gyro_y", 0.0625), ("gyro_z", 0.0625),
+    ("angle_x", 0.0054931640625), ("angle_y", 0.0054931640625), ("angle_z", 0.0054931640625),
+    ("field_strength_x", 0.006103515625), ("field_strength_y", 0.006103515625),
+    ("field_strength_z", 0.006103515625),
+    ("q0", 0.000030517578125), ("q1", 0.000030517578125),
+    ("q2", 0.000030517578125), ("q3", 0.000030517578125),
+    ("temperature", 0.01), ("pressure", 0.0002384185791), ("height", 0.0010728836),
+]
+
+
+def decode(data):
+    pos = 0
+    next_counter = None
+    while True:
+        pos = data.find(b"AS", pos)
+        if pos < 0 or pos + HEADER.size > len(data):
+            return
+        magic, version, count, counter, timestamp = HEADER.unpack_from(data, pos)
+        end = pos + HEADER.size + count * SAMPLE.size
+        if version != VERSION or count == 0 or end > len(data):
+            pos += 1
+            continue
+        if next_counter is not None and counter != next_counter:
+            print(f"# gap: expected frame {next_counter}, got {counter}", file=sys.stderr)
+        next_counter = (counter + count) & 0xFFFF
+        t = timestamp
+        for i in range(count):
+            fields = SAMPLE.unpack_from(data, pos + HEADER.size + i * SAMPLE.size)
+            t += fields[0]
+            yield (counter + i) & 0xFFFF, t, fields[1:]
+        pos = end
+
+
+def main():
+    parser = argparse.ArgumentParser(description="decode as201 export batches to csv")
+    parser.add_argument("input", help="binary capture file")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+    print(",".join(["frame", "time_ms"] + [name for name, _ in COLUMNS]))
+    for frame, t, fields in decode(data):
+        values = [f"{raw * scale:.6g}" for raw, (_, scale) in zip(fields, COLUMNS)]
+        print(",".join([str(frame), str(t)] + values))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
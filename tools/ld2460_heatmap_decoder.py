@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+"""
+把 ld2460.export_heatmap 导出的热力图解码成 csv 网格或者 pgm 灰度图
+
+    python3 tools/stream_client_udp_receiver.py --output heatmap.bin
+    python3 tools/ld2460_heatmap_decoder.py heatmap.bin > heatmap.csv
+    python3 tools/ld2460_heatmap_decoder.py heatmap.bin --pgm heatmap.pgm
+
+格式(小端):
+    头: 'H' 'M' version(u8) cell_size(u8 cm) width(u8) height(u8) x_min(i16 cm) y_min(i16 cm) reserved(u8)
+    数据: (run u8, value u16) 游程, 按行展开, 共 width * height 个格子
+    每个计数约等于一个 sample_interval 的停留时间
+"""
+import argparse
+import struct
+import sys
+
+HEADER = struct.Struct("<2sBBBBhhB")
+RUN = struct.Struct("<BH")
+VERSION = 1
+
+
+def decode(data):
+    magic, version, cell_cm, width, height, x_min, y_min, _ = HEADER.unpack_from(data, 0)
+    if magic != b"HM" or version != VERSION:
+        raise ValueError("not an ld2460 heatmap")
+    cells = []
+    pos = HEADER.size
+    while len(cells) < width * height and pos + RUN.size <= len(data):
+        run, value = RUN.unpack_from(data, pos)
+        cells.extend([value] * run)
+        pos += RUN.size
+    if len(cells) != width * height:
+        raise ValueError(f"truncated heatmap: {len(cells)} of {width * height} cells")
+    grid = [cells[row * width:(row + 1) * width] for row in range(height)]
+    return cell_cm / 100, x_min / 100, y_min / 100, grid
+
+
+def main():
+    parser = argparse.ArgumentParser(description="decode ld2460 heatmap export")
+    parser.add_argument("input", help="binary heatmap blob")
+    parser.add_argument("--pgm", help="also write a pgm image, far rows on top")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        cell_size, x_min, y_min, grid = decode(f.read())
+    width = len(grid[0])
+    print("y\\x," + ",".join(f"{x_min + (col + 0.5) * cell_size:.2f}" for col in range(width)))
+    for row, values in enumerate(grid):
+        print(f"{y_min + (row + 0.5) * cell_size:.2f}," + ",".join(str(v) for v in values))
+    if args.pgm:
+        peak = max(max(values) for values in grid) or 1
+        with open(args.pgm, "wb") as f:
+            f.write(f"P5 {width} {len(grid)} 255\n".encode())
+            for values in reversed(grid):
+                f.write(bytes(v * 255 // peak for v in values))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,836 @@
+#!/usr/bin/env python3
+"""
+在电脑上回放串口字节流, 测试和对比各雷达/传感器组件 loop() 里的帧解析
+
+    python3 tools/parser_bench.py                      # 全部解析器, 合成数据
+    python3 tools/parser_bench.py ld2451 ld2460 --frames 50000 --fault-rate 0.05
+    python3 tools/parser_bench.py ld2460 --capture ld2460.bin    # 回放抓到的原始字节流
+    python3 tools/parser_bench.py --json > before.json           # 保存结果, 优化后对比
+
+脚本把最小的 esphome 头文件替身写到临时目录, 用 g++ 把组件源码和回放驱动编译成一个
+本机程序. 驱动按 --chunk 字节一块把数据喂给 UARTDevice 替身, 每喂一块调一次 loop(),
+数据喂完后继续调 loop() 直到不再解析出新帧.
+
+合成数据在每个正常帧里写入递增序号, 由"探针"传感器发布出来, 据此统计:
+    decoded   解析出的正常帧
+    lost      丢失的正常帧 (一般发生在故障之后, 反映重新同步的代价)
+    spurious  发布了不存在的序号 (垃圾数据被当成了帧)
+    corrupt   被接受的损坏帧 (翻转了一个字节但没被校验出来)
+故障按 --fault-rate 插在帧之间: 随机垃圾字节, 只发了一半的帧, 翻转一个字节的帧.
+
+性能: 帧/秒, 每帧纳秒, 每帧堆分配次数 (替换全局 operator new 计数), 以及 ESP_LOGW 次数.
+耗时取 --repeat 次中最好的一次, 只用于同一台机器上的前后对比.
+"""
+import argparse
+import bisect
+import json
+import math
+import os
+import random
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+
+REPO = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+COMPONENTS = os.path.join(REPO, "components")
+
+
+# ---------------------------------------------------------------------------
+# 各协议的帧构造, 探针解码
+# ---------------------------------------------------------------------------
+
+def ld2413_frame(seq):
+    return bytes([0xFD, 0xFC, 0xFB, 0xFA, 0x04, 0x00]) + struct.pack("<f", seq) + bytes([0x04, 0x03, 0x02, 0x01])
+
+
+def ld2451_frame(seq):
+    # 目标数, 是否有靠近目标, 目标: 角度+0x80, 距离, 方向, 速度, 信噪比
+    payload = bytes([1, 1, 0x80, seq & 0xFF, 1, 10, 50])
+    return (bytes([0xFD, 0xFC, 0xFB, 0xFA]) + struct.pack("<H", len(payload)) + payload +
+            bytes([0x04, 0x03, 0x02, 0x01]))
+
+
+def ld2460_frame(seq):
+    # 帧长包含帧头帧尾, 每个目标 x/y 各 int16, 单位 0.1 米
+    targets = struct.pack("<hh", seq % 30000, 15)
+    size = 11 + len(targets)
+    return (bytes([0xF4, 0xF3, 0xF2, 0xF1, 0x04]) + struct.pack("<H", size) + targets +
+            bytes([0xF8, 0xF7, 0xF6, 0xF5]))
+
+
+def as201_frame(seq):
+    # FA FB len cmd type data(42) checksum FC FD, 温度在数据区偏移 32
+    data = bytearray(42)
+    struct.pack_into("<h", data, 32, seq % 30000)
+    body = bytes([0x00, 0x0F]) + bytes(data)
+    checksum = sum(body) & 0xFF
+    return bytes([0xFA, 0xFB, len(body) + 1]) + body + bytes([checksum, 0xFC, 0xFD])
+
+
+def zexx_frame(seq):
+    frame = bytearray([0xFF, 0x86, 0x00, 0x00, (seq >> 8) & 0xFF, seq & 0xFF, 0x00, 0x00])
+    frame.append((~sum(frame[1:]) + 1) & 0xFF)
+    return bytes(frame)
+
+
+# probe: 驱动里接到探针传感器上的语句, c 是组件指针, probe 是探针传感器
+PARSERS = {
+    "ld2413": {
+        "sources": ["ld2413"],
+        "header": "ld2413/ld2413.h",
+        "class": "ld2413::LD2413Component",
+        "probe": "c->set_distance_sensor(probe);",
+        "frame": ld2413_frame,
+        "decode": lambda v: int(round(v)),
+        "modulus": 1 << 24,
+    },
+    "ld2451": {
+        "sources": ["ld2451"],
+        "header": "ld2451/ld2451.h",
+        "class": "ld2451::LD2451Component",
+        "probe": "c->set_target_distance_sensor(0, probe);",
+        "frame": ld2451_frame,
+        "decode": lambda v: int(round(v)),
+        "modulus": 256,
+    },
+    "ld2460": {
+        "sources": ["ld2460"],
+        "header": "ld2460/ld2460.h",
+        "class": "ld2460::LD2460Component",
+        "probe": "c->set_target_x_sensor(0, probe);",
+        "frame": ld2460_frame,
+        "decode": lambda v: int(round(v * 10)),
+        "modulus": 30000,
+    },
+    "as201": {
+        "sources": ["as201"],
+        "header": "as201/as201.h",
+        "class": "as201::AS201Component",
+        "probe": "c->set_temperature_sensor(probe);",
+        "frame": as201_frame,
+        "decode": lambda v: int(round(v * 100)),
+        "modulus": 30000,
+    },
+    "zexx": {
+        "sources": ["zexx"],
+        "header": "zexx/zexx.h",
+        "class": "zexx::ZEXXComponent",
+        "probe": "c->set_mode(zexx::ZEXX_MODE_ACTIVE);\n  c->set_gas_sensor(probe);",
+        "frame": zexx_frame,
+        "decode": lambda v: int(round(v)),
+        "modulus": 65536,
+    },
+}
+
+
+# ---------------------------------------------------------------------------
+# 合成字节流
+# ---------------------------------------------------------------------------
+
+def synthesize(parser, frames, fault_rate, rng):
+    """返回 (字节流, 事件列表), 事件是 (序号, 'good' 或 'corrupt'), 按流中顺序"""
+    build = PARSERS[parser]["frame"]
+    modulus = PARSERS[parser]["modulus"]
+    stream = bytearray()
+    events = []
+    faults = 0
+    for seq in range(frames):
+        frame = build(seq % modulus)
+        if rng.random() >= fault_rate:
+            stream += frame
+            events.append((seq % modulus, "good"))
+            continue
+        faults += 1
+        kind = rng.randrange(3)
+        if kind == 0:  # 随机垃圾, 再接正常帧
+            stream += bytes(rng.randrange(256) for _ in range(rng.randint(1, 64)))
+            stream += frame
+            events.append((seq % modulus, "good"))
+        elif kind == 1:  # 半帧, 这一帧本来就收不到
+            stream += frame[:rng.randint(1, len(frame) - 1)]
+        else:  # 翻转一个字节
+            bad = bytearray(frame)
+            bad[rng.randrange(len(bad))] ^= 1 << rng.randrange(8)
+            stream += bad
+            events.append((seq % modulus, "corrupt"))
+    return bytes(stream), events, faults
+
+
+def match(decoded, events, window):
+    """按顺序把发布的序号对到事件上, 往后 window 个事件内都找不到的算 spurious"""
+    positions = {}
+    for i, (seq, _) in enumerate(events):
+        positions.setdefault(seq, []).append(i)
+    result = {"good": 0, "corrupt": 0, "spurious": 0}
+    j = 0
+    for value in decoded:
+        candidates = positions.get(value, [])
+        k = bisect.bisect_left(candidates, j)
+        if k < len(candidates) and candidates[k] - j < window:
+            result[events[candidates[k]][1]] += 1
+            j = candidates[k] + 1
+        else:
+            result["spurious"] += 1
+    return result
+
+
+# ---------------------------------------------------------------------------
+# esphome 替身和回放驱动
+# ---------------------------------------------------------------------------
+
+SHIMS = {
+    "esphome/core/defines.h": """
+#pragma once
+#define USE_SENSOR
+#define USE_TEXT_SENSOR
+#define USE_BINARY_SENSOR
+#define USE_BUTTON
+#define USE_SELECT
+#define USE_SWITCH
+#define USE_NUMBER
+""",
+    "esphome/core/hal.h": """
+#pragma once
+#include <cstdint>
+namespace esphome {
+extern uint32_t bench_now;
+inline uint32_t millis() { return bench_now; }
+inline uint32_t micros() { return bench_now * 1000; }
+inline void delay(uint32_t ms) { bench_now += ms; }
+inline void delayMicroseconds(uint32_t) {}
+}  // namespace esphome
+""",
+    "esphome/core/log.h": """
+#pragma once
+#include <cinttypes>
+#include <cstdint>
+namespace esphome { extern uint32_t bench_warnings; }
+#define ESP_LOGE(tag, ...) (++::esphome::bench_warnings)
+#define ESP_LOGW(tag, ...) (++::esphome::bench_warnings)
+#define ESP_LOGI(tag, ...) ((void) 0)
+#define ESP_LOGD(tag, ...) ((void) 0)
+#define ESP_LOGV(tag, ...) ((void) 0)
+#define ESP_LOGVV(tag, ...) ((void) 0)
+#define ESP_LOGCONFIG(tag, ...) ((void) 0)
+#define LOG_SENSOR(a, b, s) ((void) (s))
+#define LOG_BINARY_SENSOR(a, b, s) ((void) (s))
+#define LOG_TEXT_SENSOR(a, b, s) ((void) (s))
+#define LOG_BUTTON(a, b, s) ((void) (s))
+#define LOG_SELECT(a, b, s) ((void) (s))
+#define LOG_SWITCH(a, b, s) ((void) (s))
+#define LOG_NUMBER(a, b, s) ((void) (s))
+#define LOG_UPDATE_INTERVAL(x) ((void) (x))
+#define YESNO(b) ((b) ? "YES" : "NO")
+#define ONOFF(b) ((b) ? "ON" : "OFF")
+""",
+    "esphome/core/helpers.h": """
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+namespace esphome {
+template<typename T> T clamp(T v, T lo, T hi) { return v < lo ? lo : (v > hi ? hi : v); }
+inline uint32_t fnv1_hash(const std::string &s) {
+  uint32_t h = 2166136261UL;
+  for (char c : s) { h *= 16777619UL; h ^= (uint8_t) c; }
+  return h;
+}
+template<typename T> class Parented {
+ public:
+  void set_parent(T *p) { parent_ = p; }
+  T *get_parent() const { return parent_; }
+ protected:
+  T *parent_{nullptr};
+};
+template<typename F> class CallbackManager;
+template<typename... Ts> class CallbackManager<void(Ts...)> {
+ public:
+  void add(std::function<void(Ts...)> &&f) { cbs_.push_back(std::move(f)); }
+  void call(Ts... a) { for (auto &c : cbs_) c(a...); }
+ protected:
+  std::vector<std::function<void(Ts...)>> cbs_;
+};
+template<typename F> class LazyCallbackManager : public CallbackManager<F> {};
+inline std::string format_hex_pretty(const uint8_t *, size_t) { return ""; }
+inline std::string str_sprintf(const char *, ...) { return ""; }
+}  // namespace esphome
+""",
+    "esphome/core/preferences.h": """
+#pragma once
+#include <cstdint>
+namespace esphome {
+class ESPPreferenceObject {
+ public:
+  template<typename T> bool save(const T *) { return true; }
+  template<typename T> bool load(T *) { return false; }
+};
+class ESPPreferences {
+ public:
+  template<typename T> ESPPreferenceObject make_preference(uint32_t, bool = false) { return {}; }
+  bool sync() { return true; }
+};
+extern ESPPreferences *global_preferences;
+}  // namespace esphome
+""",
+    "esphome/core/component.h": """
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/preferences.h"
+namespace esphome {
+namespace setup_priority {
+const float BUS = 1000;
+const float HARDWARE = 800;
+const float DATA = 600;
+const float PROCESSOR = 400;
+const float AFTER_WIFI = 200;
+const float AFTER_CONNECTION = 100;
+const float LATE = -100;
+}  // namespace setup_priority
+// 定时器不执行, 回放只关心 loop() 里的解析
+class Component {
+ public:
+  virtual ~Component() = default;
+  virtual void setup() {}
+  virtual void loop() {}
+  virtual void dump_config() {}
+  virtual void on_shutdown() {}
+  virtual float get_setup_priority() const { return 0; }
+  void mark_failed() {}
+  bool is_failed() const { return false; }
+  void status_set_warning(const char * = nullptr) {}
+  void status_clear_warning() {}
+  void status_set_error(const char * = nullptr) {}
+  void status_clear_error() {}
+  void set_timeout(uint32_t, std::function<void()> &&) {}
+  void set_timeout(const std::string &, uint32_t, std::function<void()> &&) {}
+  bool cancel_timeout(const std::string &) { return true; }
+  void set_interval(uint32_t, std::function<void()> &&) {}
+  void set_interval(const std::string &, uint32_t, std::function<void()> &&) {}
+  bool cancel_interval(const std::string &) { return true; }
+  void defer(std::function<void()> &&) {}
+};
+class PollingComponent : public Component {
+ public:
+  virtual void update() = 0;
+  void set_update_interval(uint32_t v) { update_interval_ = v; }
+  uint32_t get_update_interval() const { return update_interval_; }
+ protected:
+  uint32_t update_interval_{0};
+};
+}  // namespace esphome
+""",
+    "esphome/core/automation.h": """
+#pragma once
+#include <functional>
+#include "esphome/core/component.h"
+namespace esphome {
+template<typename T, typename... X> class TemplatableValue {
+ public:
+  TemplatableValue() = default;
+  TemplatableValue(T v) : v_(v) {}
+  T value(X...) const { return v_; }
+ protected:
+  T v_{};
+};
+#define TEMPLATABLE_VALUE(type, name) \\
+ protected: \\
+  TemplatableValue<type, Ts...> name##_{}; \\
+ public: \\
+  template<typename V> void set_##name(V name) { this->name##_ = name; }
+template<typename... Ts> class Action {
+ public:
+  virtual ~Action() = default;
+  virtual void play(const Ts &...x) = 0;
+};
+template<typename... Ts> class Trigger {
+ public:
+  void trigger(const Ts &...) {}
+};
+}  // namespace esphome
+""",
+    "esphome/components/uart/uart.h": """
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "esphome/core/component.h"
+namespace esphome {
+namespace uart {
+// 所有设备共用一个回放缓冲, limit 之前的字节视为已经到达
+struct BenchStream {
+  const uint8_t *data{nullptr};
+  size_t pos{0};
+  size_t limit{0};
+};
+extern BenchStream bench_stream;
+class UARTComponent {
+ public:
+  void write_array(const uint8_t *, size_t) {}
+  uint32_t get_baud_rate() const { return 115200; }
+  void set_baud_rate(uint32_t) {}
+  void load_settings(bool = true) {}
+};
+class UARTDevice {
+ public:
+  void set_uart_parent(UARTComponent *p) { parent_ = p; }
+  void check_uart_settings(uint32_t, uint8_t = 1) {}
+  void write(uint8_t) {}
+  void write_byte(uint8_t) {}
+  void write_array(const uint8_t *, size_t) {}
+  void write_array(const std::vector<uint8_t> &) {}
+  template<size_t N> void write_array(const std::array<uint8_t, N> &) {}
+  void write_str(const char *) {}
+  void flush() {}
+  int available() { return (int) (bench_stream.limit - bench_stream.pos); }
+  int read() {
+    uint8_t b;
+    return read_byte(&b) ? b : -1;
+  }
+  bool read_byte(uint8_t *b) { return read_array(b, 1); }
+  bool peek_byte(uint8_t *b) {
+    if (available() < 1)
+      return false;
+    *b = bench_stream.data[bench_stream.pos];
+    return true;
+  }
+  bool read_array(uint8_t *out, size_t n) {
+    if ((size_t) available() < n)
+      return false;
+    memcpy(out, bench_stream.data + bench_stream.pos, n);
+    bench_stream.pos += n;
+    return true;
+  }
+ protected:
+  UARTComponent *parent_{nullptr};
+};
+}  // namespace uart
+}  // namespace esphome
+""",
+    "esphome/components/sensor/sensor.h": """
+#pragma once
+#include <string>
+#include "esphome/core/component.h"
+namespace esphome {
+namespace sensor {
+class Sensor;
+extern void (*bench_on_publish)(Sensor *sensor, float state);
+class Sensor {
+ public:
+  void publish_state(float v) {
+    state = v;
+    has_state_ = true;
+    bench_on_publish(this, v);
+  }
+  float get_state() const { return state; }
+  bool has_state() const { return has_state_; }
+  float state{0};
+ protected:
+  bool has_state_{false};
+};
+}  // namespace sensor
+}  // namespace esphome
+#define SUB_SENSOR(name) \\
+ protected: \\
+  sensor::Sensor *name##_sensor_{nullptr}; \\
+ public: \\
+  void set_##name##_sensor(sensor::Sensor *s) { this->name##_sensor_ = s; }
+""",
+    "esphome/components/text_sensor/text_sensor.h": """
+#pragma once
+#include <string>
+#include "esphome/core/component.h"
+namespace esphome {
+namespace text_sensor {
+class TextSensor {
+ public:
+  void publish_state(const std::string &s) { state = s; }
+  std::string state;
+};
+}  // namespace text_sensor
+}  // namespace esphome
+#define SUB_TEXT_SENSOR(name) \\
+ protected: \\
+  text_sensor::TextSensor *name##_text_sensor_{nullptr}; \\
+ public: \\
+  void set_##name##_text_sensor(text_sensor::TextSensor *s) { this->name##_text_sensor_ = s; }
+""",
+    "esphome/components/binary_sensor/binary_sensor.h": """
+#pragma once
+#include "esphome/core/component.h"
+namespace esphome {
+namespace binary_sensor {
+class BinarySensor {
+ public:
+  void publish_state(bool s) { state = s; }
+  bool state{false};
+};
+}  // namespace binary_sensor
+}  // namespace esphome
+#define SUB_BINARY_SENSOR(name) \\
+ protected: \\
+  binary_sensor::BinarySensor *name##_binary_sensor_{nullptr}; \\
+ public: \\
+  void set_##name##_binary_sensor(binary_sensor::BinarySensor *s) { this->name##_binary_sensor_ = s; }
+""",
+    "esphome/components/switch/switch.h": """
+#pragma once
+#include "esphome/core/component.h"
+namespace esphome {
+namespace switch_ {
+class Switch {
+ public:
+  virtual ~Switch() = default;
+  void publish_state(bool s) { state = s; }
+  void turn_on() { write_state(true); }
+  void turn_off() { write_state(false); }
+  bool state{false};
+ protected:
+  virtual void write_state(bool) = 0;
+};
+}  // namespace switch_
+}  // namespace esphome
+#define SUB_SWITCH(name) \\
+ protected: \\
+  switch_::Switch *name##_switch_{nullptr}; \\
+ public: \\
+  void set_##name##_switch(switch_::Switch *s) { this->name##_switch_ = s; }
+""",
+    "esphome/components/number/number.h": """
+#pragma once
+#include "esphome/core/component.h"
+namespace esphome {
+namespace number {
+class Number {
+ public:
+  virtual ~Number() = default;
+  void publish_state(float s) { state = s; }
+  float state{0};
+ protected:
+  virtual void control(float) = 0;
+};
+}  // namespace number
+}  // namespace esphome
+#define SUB_NUMBER(name) \\
+ protected: \\
+  number::Number *name##_number_{nullptr}; \\
+ public: \\
+  void set_##name##_number(number::Number *s) { this->name##_number_ = s; }
+""",
+    "esphome/components/select/select.h": """
+#pragma once
+#include <string>
+#include "esphome/core/component.h"
+namespace esphome {
+namespace select {
+class Select {
+ public:
+  virtual ~Select() = default;
+  void publish_state(const std::string &s) { state = s; }
+  const char *current_option() const { return state.c_str(); }
+  std::string state;
+ protected:
+  virtual void control(const std::string &) = 0;
+};
+}  // namespace select
+}  // namespace esphome
+#define SUB_SELECT(name) \\
+ protected: \\
+  select::Select *name##_select_{nullptr}; \\
+ public: \\
+  void set_##name##_select(select::Select *s) { this->name##_select_ = s; }
+""",
+    "esphome/components/button/button.h": """
+#pragma once
+#include "esphome/core/component.h"
+namespace esphome {
+namespace button {
+class Button {
+ public:
+  virtual ~Button() = default;
+ protected:
+  virtual void press_action() = 0;
+};
+}  // namespace button
+}  // namespace esphome
+#define SUB_BUTTON(name) \\
+ protected: \\
+  button::Button *name##_button_{nullptr}; \\
+ public: \\
+  void set_##name##_button(button::Button *s) { this->name##_button_ = s; }
+""",
+}
+
+DRIVER = r"""
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "__HEADER__"
+
+namespace esphome {
+uint32_t bench_now = 1;
+uint32_t bench_warnings = 0;
+static ESPPreferences bench_preferences;
+ESPPreferences *global_preferences = &bench_preferences;
+namespace uart {
+BenchStream bench_stream;
+}
+namespace sensor {
+static Sensor *bench_probe = nullptr;
+static std::vector<float> *bench_values = nullptr;
+static uint64_t bench_publishes = 0;
+static void bench_record(Sensor *s, float v) {
+  bench_publishes++;
+  if (s == bench_probe && bench_values != nullptr)
+    bench_values->push_back(v);
+}
+void (*bench_on_publish)(Sensor *sensor, float state) = bench_record;
+}  // namespace sensor
+}  // namespace esphome
+
+static bool g_counting = false;
+static uint64_t g_allocs = 0;
+void *operator new(size_t n) {
+  if (g_counting)
+    g_allocs++;
+  void *p = std::malloc(n ? n : 1);
+  if (p == nullptr)
+    throw std::bad_alloc();
+  return p;
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+using namespace esphome;
+
+// 返回解析出的探针值个数, 调用 loop() 的次数放在 loops
+static size_t replay(const std::vector<uint8_t> &data, size_t chunk, std::vector<float> *values, uint64_t *loops) {
+  auto *c = new __CLASS__();
+  auto *probe = new sensor::Sensor();
+  sensor::bench_probe = probe;
+  __PROBE__
+  values->clear();
+  values->reserve(data.size() / 8 + 16);
+  sensor::bench_values = values;
+  uart::bench_stream = {data.data(), 0, 0};
+  bench_now = 1;
+  *loops = 0;
+  while (uart::bench_stream.limit < data.size()) {
+    uart::bench_stream.limit = std::min(data.size(), uart::bench_stream.limit + chunk);
+    c->loop();
+    bench_now++;
+    (*loops)++;
+  }
+  // 数据到齐后继续调用, 直到连续几次都没有新的发布
+  uint64_t idle = 0;
+  uint64_t published = sensor::bench_publishes;
+  while (idle < 8) {
+    c->loop();
+    bench_now++;
+    (*loops)++;
+    idle = sensor::bench_publishes == published ? idle + 1 : 0;
+    published = sensor::bench_publishes;
+  }
+  sensor::bench_values = nullptr;
+  return values->size();
+}
+
+int main(int argc, char **argv) {
+  if (argc < 5) {
+    std::fprintf(stderr, "usage: %s stream.bin values.bin chunk repeat\n", argv[0]);
+    return 2;
+  }
+  FILE *f = std::fopen(argv[1], "rb");
+  if (f == nullptr)
+    return 2;
+  std::vector<uint8_t> data;
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0)
+    data.insert(data.end(), buf, buf + n);
+  std::fclose(f);
+  size_t chunk = std::strtoul(argv[3], nullptr, 10);
+  int repeat = std::atoi(argv[4]);
+
+  std::vector<float> values;
+  uint64_t loops = 0;
+  // 第一轮只统计分配和告警, 不计时
+  g_counting = true;
+  size_t frames = replay(data, chunk, &values, &loops);
+  g_counting = false;
+  uint64_t allocs = g_allocs;
+  uint32_t warnings = bench_warnings;
+  double best = 0;
+  for (int i = 0; i < repeat; i++) {
+    auto start = std::chrono::steady_clock::now();
+    replay(data, chunk, &values, &loops);
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    if (i == 0 || ns < best)
+      best = ns;
+  }
+  FILE *out = std::fopen(argv[2], "wb");
+  std::fwrite(values.data(), sizeof(float), values.size(), out);
+  std::fclose(out);
+  std::printf("%zu %zu %.0f %llu %u %llu\n", data.size(), frames, best, (unsigned long long) allocs, warnings,
+              (unsigned long long) loops);
+  return 0;
+}
+"""
+
+
+def write_shims(root):
+    for path, content in SHIMS.items():
+        full = os.path.join(root, path)
+        os.makedirs(os.path.dirname(full), exist_ok=True)
+        with open(full, "w") as f:
+            f.write(content.lstrip())
+
+
+def build(parser, workdir, cxx, cxxflags):
+    spec = PARSERS[parser]
+    driver = (DRIVER.replace("__HEADER__", spec["header"]).replace("__CLASS__", spec["class"])
+              .replace("__PROBE__", spec["probe"]))
+    driver_path = os.path.join(workdir, f"bench_{parser}.cpp")
+    with open(driver_path, "w") as f:
+        f.write(driver)
+    sources = [driver_path]
+    for source in spec["sources"]:
+        for dirpath, _, files in os.walk(os.path.join(COMPONENTS, source)):
+            sources += [os.path.join(dirpath, name) for name in sorted(files) if name.endswith(".cpp")]
+    binary = os.path.join(workdir, f"bench_{parser}")
+    cmd = [cxx, "-std=gnu++17", "-Wall", "-Wextra", *cxxflags.split(), "-I", os.path.join(workdir, "shim"), "-I",
+           COMPONENTS, *sources, "-o", binary]
+    result = subprocess.run(cmd, capture_output=True, text=True)
+    if result.returncode != 0:
+        sys.stderr.write(result.stderr)
+        raise SystemExit(f"{parser}: build failed")
+    # 解析器的告警在主机上一样有意义, 打印出来而不是吞掉
+    warnings = sum(1 for line in result.stderr.splitlines() if ": warning:" in line)
+    if warnings:
+        sys.stderr.write(result.stderr)
+        sys.stderr.write(f"{parser}: {warnings} compiler warning(s)\n")
+    return binary
+
+
+def run(parser, binary, stream, events, faults, workdir, chunk, repeat):
+    stream_path = os.path.join(workdir, f"{parser}.bin")
+    values_path = os.path.join(workdir, f"{parser}.values")
+    with open(stream_path, "wb") as f:
+        f.write(stream)
+    out = subprocess.run([binary, stream_path, values_path, str(chunk), str(repeat)], capture_output=True, text=True,
+                         check=True).stdout.split()
+    size, frames, allocs, warnings, loops = (int(out[i]) for i in (0, 1, 3, 4, 5))
+    ns = float(out[2])
+    result = {
+        "parser": parser,
+        "bytes": size,
+        "decoded": frames,
+        "frames_per_s": frames / (ns / 1e9) if ns > 0 else 0,
+        "ns_per_frame": ns / frames if frames else 0,
+        "ns_per_byte": ns / size if size else 0,
+        "allocs_per_frame": allocs / frames if frames else 0,
+        "warnings": warnings,
+        "loops": loops,
+    }
+    if events is not None:
+        with open(values_path, "rb") as f:
+            raw = f.read()
+        decode = PARSERS[parser]["decode"]
+        modulus = PARSERS[parser]["modulus"]
+        # NaN 是目标消失时的清空, 不算帧
+        decoded = [decode(v) % modulus for (v,) in struct.iter_unpack("<f", raw) if math.isfinite(v)]
+        # 序号会回绕, 只在半个周期内匹配
+        matched = match(decoded, events, max(64, modulus // 2))
+        good = sum(1 for _, kind in events if kind == "good")
+        result.update({
+            "frames": good,
+            "faults": faults,
+            "lost": good - matched["good"],
+            "spurious": matched["spurious"],
+            "corrupt": matched["corrupt"],
+        })
+    return result
+
+
+COLUMNS = [("parser", "{:<8}"), ("bytes", "{:>9}"), ("frames", "{:>7}"), ("decoded", "{:>7}"), ("faults", "{:>6}"),
+           ("lost", "{:>6}"), ("spurious", "{:>8}"), ("corrupt", "{:>7}"), ("frames_per_s", "{:>12.0f}"),
+           ("ns_per_frame", "{:>12.1f}"), ("allocs_per_frame", "{:>16.2f}"), ("warnings", "{:>8}")]
+
+
+def print_table(results):
+    print(" ".join("{:>{}}".format(name, len(name)) for name, _ in COLUMNS))
+    for r in results:
+        cells = []
+        for name, fmt in COLUMNS:
+            if name in r:
+                cells.append(fmt.format(r[name]))
+            else:  # 回放抓包时没有序号统计
+                cells.append("{:>{}}".format("-", len(fmt.format(0))))
+        print(" ".join(cells))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("parsers", nargs="*", help="要测试的解析器: " + ", ".join(sorted(PARSERS)) + ", 默认全部")
+    parser.add_argument("--frames", type=int, default=20000, help="合成数据的帧数")
+    parser.add_argument("--fault-rate", type=float, default=0.02, help="每帧插入故障的概率")
+    parser.add_argument("--seed", type=int, default=1, help="随机数种子, 固定后结果可复现")
+    parser.add_argument("--capture", help="回放抓到的原始字节流而不是合成数据, 只能指定一个解析器")
+    parser.add_argument("--chunk", type=int, default=32, help="每次 loop() 之前到达的字节数")
+    parser.add_argument("--repeat", type=int, default=5, help="计时轮数, 取最好的一次")
+    parser.add_argument("--cxx", default=os.environ.get("CXX", "g++"))
+    parser.add_argument("--cxxflags", default="-O2", help="编译选项")
+    parser.add_argument("--json", action="store_true", help="输出 json, 方便保存后对比")
+    parser.add_argument("--keep", action="store_true", help="保留临时目录(驱动源码, 替身头文件, 数据)")
+    args = parser.parse_args()
+
+    parsers = args.parsers or sorted(PARSERS)
+    for name in parsers:
+        if name not in PARSERS:
+            parser.error(f"未知的解析器 {name}")
+    if args.capture and len(parsers) != 1:
+        parser.error("--capture 需要正好指定一个解析器")
+    if args.chunk < 1:
+        parser.error("--chunk 至少为 1")
+
+    workdir = tempfile.mkdtemp(prefix="parser_bench_")
+    results = []
+    try:
+        write_shims(os.path.join(workdir, "shim"))
+        for name in parsers:
+            binary = build(name, workdir, args.cxx, args.cxxflags)
+            if args.capture:
+                with open(args.capture, "rb") as f:
+                    stream = f.read()
+                events, faults = None, 0
+            else:
+                stream, events, faults = synthesize(name, args.frames, args.fault_rate, random.Random(args.seed))
+            results.append(run(name, binary, stream, events, faults, workdir, args.chunk, args.repeat))
+    finally:
+        if args.keep:
+            print(f"workdir: {workdir}", file=sys.stderr)
+        else:
+            shutil.rmtree(workdir, ignore_errors=True)
+
+    if args.json:
+        json.dump(results, sys.stdout, indent=2)
+        print()
+    else:
+        print_table(results)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+"""
+stream_client udp 模式的接收端, 统计丢包, 乱序和抖动
+
+数据报格式: seq(u32 LE) + millis(u32 LE) + 串口数据
+
+    python3 tools/stream_client_udp_receiver.py --port 6638
+    python3 tools/stream_client_udp_receiver.py --port 6638 --output radar.bin
+
+抖动按 RFC 3550 的到达间隔抖动计算, 设备时钟和主机时钟不需要同步.
+"""
+import argparse
+import socket
+import struct
+import sys
+import time
+
+HEADER = struct.Struct("<II")
+# 序号往回跳超过这么多认为设备重启了, 而不是乱序
+RESTART_GAP = 4096
+
+
+class Stats:
+    def __init__(self):
+        self.reset()
+
+    def reset(self):
+        self.received = 0
+        self.bytes = 0
+        self.lost = 0
+        self.reordered = 0
+        self.duplicated = 0
+        self.restarts = 0
+        self.jitter = 0.0
+        self.max_transit_delta = 0.0
+        self.window_start = time.monotonic()
+
+    def report(self):
+        elapsed = max(time.monotonic() - self.window_start, 1e-6)
+        expected = self.received + self.lost
+        loss = 100.0 * self.lost / expected if expected else 0.0
+        print(
+            f"rx {self.received:6d} pkt {self.bytes / elapsed / 1024:8.2f} KiB/s | "
+            f"lost {self.lost} ({loss:.2f}%) reordered {self.reordered} dup {self.duplicated} "
+            f"restart {self.restarts} | "
+            f"jitter {self.jitter:.2f} ms max {self.max_transit_delta:.2f} ms",
+            flush=True,
+        )
+
+
+def main():
+    parser = argparse.ArgumentParser(description="stream_client udp receiver")
+    parser.add_argument("--bind", default="0.0.0.0", help="listen address")
+    parser.add_argument("--port", type=int, default=6638, help="listen port")
+    parser.add_argument("--interval", type=float, default=5.0, help="report interval in seconds")
+    parser.add_argument("--output", help="append payload bytes to this file")
+    args = parser.parse_args()
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind((args.bind, args.port))
+    sock.settimeout(0.5)
+    out = open(args.output, "ab") if args.output else None
+
+    stats = Stats()
+    next_seq = None
+    last_transit = None
+    seen = set()
+    # 本统计窗口里算作丢包的序号, 迟到的包只有在这里面才从 lost 里减掉
+    missing = set()
+    next_report = time.monotonic() + args.interval
+    print(f"listening on {args.bind}:{args.port}", flush=True)
+    try:
+        while True:
+            try:
+                data, _ = sock.recvfrom(2048)
+            except socket.timeout:
+                data = None
+            now = time.monotonic()
+            if data is not None and len(data) >= HEADER.size:
+                seq, sent_ms = HEADER.unpack_from(data)
+                payload = data[HEADER.size:]
+                if next_seq is not None and next_seq - seq > RESTART_GAP:
+                    # 设备重启后序号从 0 开始, 重新建立基准
+                    stats.restarts += 1
+                    next_seq = None
+                    last_transit = None
+                    seen.clear()
+                    missing.clear()
+                if seq in seen:
+                    stats.duplicated += 1
+                else:
+                    seen.add(seq)
+                    if len(seen) > 4096:
+                        seen = {s for s in seen if s > seq - 2048}
+                    if next_seq is None or seq >= next_seq:
+                        if next_seq is not None:
+                            stats.lost += seq - next_seq
+                            if seq - next_seq <= 4096:
+                                missing.update(range(next_seq, seq))
+                        next_seq = seq + 1
+                    else:
+                        stats.reordered += 1
+                        if seq in missing:
+                            # 迟到的包之前被算成丢包了
+                            missing.discard(seq)
+                            stats.lost = max(stats.lost - 1, 0)
+                    stats.received += 1
+                    stats.bytes += len(payload)
+                    transit = now * 1000.0 - sent_ms
+                    if last_transit is not None:
+                        d = abs(transit - last_transit)
+                        stats.jitter += (d - stats.jitter) / 16.0
+                        stats.max_transit_delta = max(stats.max_transit_delta, d)
+                    last_transit = transit
+                    if out is not None:
+                        out.write(payload)
+            if now >= next_report:
+                stats.report()
+                jitter = stats.jitter
+                stats.reset()
+                stats.jitter = jitter
+                missing.clear()
+                next_report = now + args.interval
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if out is not None:
+            out.close()
+        sock.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())